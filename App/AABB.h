@@ -0,0 +1,30 @@
+#pragma once
+#include "Vec2.h"
+#include "Maths.h"
+
+// Extra space added around every proxy in the broad phase, so small movements don't force the tree to update.
+constexpr float AABBMargin = 0.1f;
+
+struct AABB {
+
+	Vec2 min;
+	Vec2 max;
+
+	[[nodiscard]] bool Overlaps(const AABB& other) const {
+		return min.x <= other.max.x && max.x >= other.min.x && min.y <= other.max.y && max.y >= other.min.y;
+	}
+
+	[[nodiscard]] bool Contains(const AABB& other) const {
+		return min.x <= other.min.x && min.y <= other.min.y && max.x >= other.max.x && max.y >= other.max.y;
+	}
+
+	[[nodiscard]] Vec2 GetCentre() const { return 0.5f * (min + max); }
+	[[nodiscard]] Vec2 GetExtents() const { return 0.5f * (max - min); }
+
+	// NOTE: In 2D the "surface area" heuristic uses the perimeter instead.
+	[[nodiscard]] float GetPerimeter() const { return 2.0f * ((max.x - min.x) + (max.y - min.y)); }
+
+	[[nodiscard]] static AABB Combine(const AABB& a, const AABB& b) {
+		return { { Min(a.min.x, b.min.x), Min(a.min.y, b.min.y) }, { Max(a.max.x, b.max.x), Max(a.max.y, b.max.y) } };
+	}
+};
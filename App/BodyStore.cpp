@@ -0,0 +1,155 @@
+#include "BodyStore.h"
+#include <algorithm>
+#include <utility>
+
+BodyHandle BodyStore::CreateBody(Vec2 position, Vec2 velocity, float orientation, float invMass, float invMoment)
+{
+	BodyHandle handle;
+	if (!m_freeHandles.empty()) {
+		handle = m_freeHandles.back();
+		m_freeHandles.pop_back();
+	}
+	else {
+		handle = static_cast<BodyHandle>(m_handleToIndex.size());
+		m_handleToIndex.push_back(-1);
+	}
+
+	m_handleToIndex[handle] = GetCount();
+	m_indexToHandle.push_back(handle);
+
+	positionX.push_back(position.x);
+	positionY.push_back(position.y);
+	velocityX.push_back(velocity.x);
+	velocityY.push_back(velocity.y);
+	this->orientation.push_back(orientation);
+	previousPositionX.push_back(position.x);
+	previousPositionY.push_back(position.y);
+	previousOrientation.push_back(orientation);
+	angularVelocity.push_back(0.0f);
+	this->invMass.push_back(invMass);
+	this->invMoment.push_back(invMoment);
+	forceX.push_back(0.0f);
+	forceY.push_back(0.0f);
+	torque.push_back(0.0f);
+	sleepTime.push_back(0.0f);
+
+	// New bodies start awake (unless they're static, since those never move).
+	if (invMass > 0.0f) SetAwake(m_handleToIndex[handle], true);
+
+	return handle;
+}
+
+void BodyStore::DestroyBody(BodyHandle handle)
+{
+	int index = m_handleToIndex[handle];
+	if (IsAwake(index)) {
+		SetAwake(index, false);
+		index = m_handleToIndex[handle];
+	}
+
+	// Move the last body into the hole so the arrays stay packed.
+	const int last = GetCount() - 1;
+	SwapBodies(index, last);
+
+	positionX.pop_back();
+	positionY.pop_back();
+	velocityX.pop_back();
+	velocityY.pop_back();
+	orientation.pop_back();
+	previousPositionX.pop_back();
+	previousPositionY.pop_back();
+	previousOrientation.pop_back();
+	angularVelocity.pop_back();
+	invMass.pop_back();
+	invMoment.pop_back();
+	forceX.pop_back();
+	forceY.pop_back();
+	torque.pop_back();
+	sleepTime.pop_back();
+
+	m_indexToHandle.pop_back();
+	m_handleToIndex[handle] = -1;
+	m_freeHandles.push_back(handle);
+}
+
+void BodyStore::SetAwake(int index, bool awake)
+{
+	if (awake == IsAwake(index)) return;
+
+	sleepTime[index] = 0.0f;
+
+	if (awake) {
+		// The first asleep body sits right after the awake ones, so swap with that and grow the awake range over it.
+		SwapBodies(index, m_awakeCount);
+		m_awakeCount++;
+	}
+	else {
+		velocityX[index] = 0.0f;
+		velocityY[index] = 0.0f;
+		angularVelocity[index] = 0.0f;
+
+		// Otherwise it'd keep getting drawn partway through its last step until it woke up again.
+		previousPositionX[index] = positionX[index];
+		previousPositionY[index] = positionY[index];
+		previousOrientation[index] = orientation[index];
+
+		m_awakeCount--;
+		SwapBodies(index, m_awakeCount);
+	}
+}
+
+void BodyStore::SavePreviousTransforms()
+{
+	std::copy(positionX.begin(), positionX.begin() + m_awakeCount, previousPositionX.begin());
+	std::copy(positionY.begin(), positionY.begin() + m_awakeCount, previousPositionY.begin());
+	std::copy(orientation.begin(), orientation.begin() + m_awakeCount, previousOrientation.begin());
+}
+
+void BodyStore::SwapBodies(int a, int b)
+{
+	if (a == b) return;
+
+	std::swap(positionX[a], positionX[b]);
+	std::swap(positionY[a], positionY[b]);
+	std::swap(velocityX[a], velocityX[b]);
+	std::swap(velocityY[a], velocityY[b]);
+	std::swap(orientation[a], orientation[b]);
+	std::swap(previousPositionX[a], previousPositionX[b]);
+	std::swap(previousPositionY[a], previousPositionY[b]);
+	std::swap(previousOrientation[a], previousOrientation[b]);
+	std::swap(angularVelocity[a], angularVelocity[b]);
+	std::swap(invMass[a], invMass[b]);
+	std::swap(invMoment[a], invMoment[b]);
+	std::swap(forceX[a], forceX[b]);
+	std::swap(forceY[a], forceY[b]);
+	std::swap(torque[a], torque[b]);
+	std::swap(sleepTime[a], sleepTime[b]);
+
+	std::swap(m_indexToHandle[a], m_indexToHandle[b]);
+	m_handleToIndex[m_indexToHandle[a]] = a;
+	m_handleToIndex[m_indexToHandle[b]] = b;
+}
+
+void BodyStore::Clear()
+{
+	positionX.clear();
+	positionY.clear();
+	velocityX.clear();
+	velocityY.clear();
+	orientation.clear();
+	previousPositionX.clear();
+	previousPositionY.clear();
+	previousOrientation.clear();
+	angularVelocity.clear();
+	invMass.clear();
+	invMoment.clear();
+	forceX.clear();
+	forceY.clear();
+	torque.clear();
+	sleepTime.clear();
+
+	m_handleToIndex.clear();
+	m_indexToHandle.clear();
+	m_freeHandles.clear();
+	m_awakeCount = 0;
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include "Vec2.h"
+#include <vector>
+
+// Stable reference to a body in the BodyStore. Unlike the index into the arrays, this never changes while the body exists.
+using BodyHandle = int;
+
+constexpr BodyHandle NullBody = -1;
+
+// Owns the simulation state of every body, stored as one array per field (structure of arrays). The integrator and the solver
+// walk these arrays directly instead of going through the PhysicsObject pointers, which keeps the hot loops cache friendly.
+//
+// The arrays are always densely packed: removing a body moves the last one into its slot. Anything that needs to hold on to a
+// body between steps should keep its handle, and look up the current index with GetIndex().
+//
+// NOTE: Awake bodies are kept at the front of the arrays, so anything that only cares about moving bodies can just loop over
+// [0, GetAwakeCount()). Static bodies never move, so they always count as asleep.
+class BodyStore {
+public:
+	BodyHandle CreateBody(Vec2 position, Vec2 velocity, float orientation, float invMass, float invMoment);
+	void DestroyBody(BodyHandle handle);
+	void Clear();
+
+	[[nodiscard]] int GetIndex(BodyHandle handle) const { return m_handleToIndex[handle]; }
+	[[nodiscard]] BodyHandle GetHandle(int index) const { return m_indexToHandle[index]; }
+	[[nodiscard]] int GetCount() const { return static_cast<int>(m_indexToHandle.size()); }
+	[[nodiscard]] int GetAwakeCount() const { return m_awakeCount; }
+
+	[[nodiscard]] bool IsAwake(int index) const { return index < m_awakeCount; }
+	[[nodiscard]] bool IsStatic(int index) const { return invMass[index] == 0.0f; }
+
+	// Moves the body in or out of the awake part of the arrays, which changes its index (and the index of whatever it swapped with).
+	// Bodies that are put to sleep lose their velocity.
+	void SetAwake(int index, bool awake);
+
+	// Call before stepping. Only the awake bodies are going to move, so the rest are left alone.
+	void SavePreviousTransforms();
+
+	[[nodiscard]] Vec2 GetPosition(int index) const { return { positionX[index], positionY[index] }; }
+	[[nodiscard]] Vec2 GetPreviousPosition(int index) const { return { previousPositionX[index], previousPositionY[index] }; }
+	[[nodiscard]] Vec2 GetVelocity(int index) const { return { velocityX[index], velocityY[index] }; }
+
+	void SetPosition(int index, Vec2 position) { positionX[index] = position.x; positionY[index] = position.y; }
+	void SetVelocity(int index, Vec2 velocity) { velocityX[index] = velocity.x; velocityY[index] = velocity.y; }
+
+	// Impulse through the contact point, so it changes the angular velocity as well.
+	void ApplyImpulse(int index, Vec2 impulse, Vec2 contactPoint)
+	{
+		velocityX[index] += impulse.x * invMass[index];
+		velocityY[index] += impulse.y * invMass[index];
+
+		const Vec2 r = contactPoint - GetPosition(index);
+		angularVelocity[index] += PseudoCross(r, impulse) * invMoment[index];
+	}
+
+	// NOTE: Public so the hot loops can index them directly. Static bodies (e.g. planes) have an inverse mass and moment of 0.
+	std::vector<float> positionX;
+	std::vector<float> positionY;
+	std::vector<float> velocityX;
+	std::vector<float> velocityY;
+	std::vector<float> orientation;
+	// Where the body was before the last step, for drawing in between steps.
+	std::vector<float> previousPositionX;
+	std::vector<float> previousPositionY;
+	std::vector<float> previousOrientation;
+	std::vector<float> angularVelocity;
+	std::vector<float> invMass;
+	std::vector<float> invMoment;
+	std::vector<float> forceX;
+	std::vector<float> forceY;
+	std::vector<float> torque;
+
+	// How long the body has been moving slowly enough to sleep.
+	std::vector<float> sleepTime;
+
+private:
+	void SwapBodies(int a, int b);
+
+	int m_awakeCount = 0;
+
+	std::vector<int> m_handleToIndex;
+	std::vector<BodyHandle> m_indexToHandle;
+
+	// Handles of destroyed bodies, so they can be reused.
+	std::vector<BodyHandle> m_freeHandles;
+};
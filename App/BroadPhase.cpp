@@ -0,0 +1,129 @@
+#include "BroadPhase.h"
+#include "PhysicsObject.h"
+#include "Plane.h"
+#include "BruteForceBroadPhase.h"
+#include "TreeBroadPhase.h"
+#include "SweepAndPrune.h"
+#include "SpatialHashGrid.h"
+#include <algorithm>
+
+std::unique_ptr<BroadPhase> BroadPhase::Create(BroadPhaseType type)
+{
+	switch (type) {
+	case BroadPhaseType::BRUTE_FORCE:
+		return std::make_unique<BruteForceBroadPhase>();
+	case BroadPhaseType::SWEEP_AND_PRUNE:
+		return std::make_unique<SweepAndPrune>();
+	case BroadPhaseType::SPATIAL_HASH:
+		return std::make_unique<SpatialHashGrid>();
+	case BroadPhaseType::AABB_TREE:
+	default:
+		return std::make_unique<TreeBroadPhase>();
+	}
+}
+
+float BroadPhase::GetSizeVariation(const std::vector<PhysicsObject*>& objects)
+{
+	float sum = 0.0f;
+	float sumSquared = 0.0f;
+	int count = 0;
+
+	for (const PhysicsObject* object : objects) {
+		if (object->m_ShapeID == ShapeType::PLANE) continue;
+
+		const Vec2 extents = object->GetAABB().GetExtents();
+		const float radius = Max(extents.x, extents.y);
+		sum += radius;
+		sumSquared += radius * radius;
+		count++;
+	}
+
+	if (count == 0 || sum <= 0.0f) return 0.0f;
+
+	const float mean = sum / count;
+	const float variance = Max(sumSquared / count - mean * mean, 0.0f);
+	return sqrtf(variance) / mean;
+}
+
+void BroadPhase::AddObject(PhysicsObject* object)
+{
+	if (object->m_ShapeID == ShapeType::PLANE) {
+		m_planes.push_back(object);
+		return;
+	}
+
+	m_bodies.push_back(object);
+	AddProxy(object);
+}
+
+void BroadPhase::RemoveObject(PhysicsObject* object)
+{
+	if (object->m_ShapeID == ShapeType::PLANE) {
+		m_planes.erase(std::remove(m_planes.begin(), m_planes.end(), object), m_planes.end());
+		return;
+	}
+
+	RemoveProxy(object);
+	m_bodies.erase(std::remove(m_bodies.begin(), m_bodies.end(), object), m_bodies.end());
+}
+
+void BroadPhase::Clear()
+{
+	ClearProxies();
+	m_bodies.clear();
+	m_planes.clear();
+}
+
+void BroadPhase::UpdatePairs(float delta, std::vector<BroadPhasePair>& pairs, bool speculative)
+{
+	pairs.clear();
+
+	m_aabbs.resize(m_bodies.size());
+	for (size_t i = 0; i < m_bodies.size(); i++) {
+		m_aabbs[i] = m_bodies[i]->GetAABB();
+
+		if (speculative && m_bodies[i]->GetSpeculative()) {
+			const Vec2 displacement = m_bodies[i]->GetVelocity() * delta;
+			const AABB moved = { m_aabbs[i].min + displacement, m_aabbs[i].max + displacement };
+			m_aabbs[i] = AABB::Combine(m_aabbs[i], moved);
+		}
+	}
+
+	FindPairs(delta, pairs);
+	FindPlanePairs(pairs);
+}
+
+void BroadPhase::Query(const AABB& aabb, std::vector<PhysicsObject*>& results) const
+{
+	results.clear();
+	results.insert(results.end(), m_planes.begin(), m_planes.end());
+	QueryBodies(aabb, results);
+}
+
+void BroadPhase::QueryBodies(const AABB& aabb, std::vector<PhysicsObject*>& results) const
+{
+	for (size_t i = 0; i < m_bodies.size(); i++) {
+		if (m_aabbs[i].Overlaps(aabb)) results.push_back(m_bodies[i]);
+	}
+}
+
+void BroadPhase::FindPlanePairs(std::vector<BroadPhasePair>& pairs) const
+{
+	for (PhysicsObject* plane : m_planes) {
+		const Plane* P = static_cast<Plane*>(plane);
+		const Vec2 normal = P->GetNormal();
+
+		for (size_t i = 0; i < m_bodies.size(); i++) {
+			const AABB& aabb = m_aabbs[i];
+
+			// Project the box extents onto the plane normal, the same way Box2Plane does for OBBs.
+			const Vec2 extents = aabb.GetExtents();
+			const float r = extents.x * abs(normal.x) + extents.y * abs(normal.y);
+			const float distance = Dot(aabb.GetCentre(), normal) - P->GetDistance();
+
+			if (abs(distance) <= r) {
+				pairs.push_back({ plane, m_bodies[i] });
+			}
+		}
+	}
+}
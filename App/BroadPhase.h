@@ -0,0 +1,62 @@
+#pragma once
+#include "AABB.h"
+#include <vector>
+#include <memory>
+
+class PhysicsObject;
+
+enum class BroadPhaseType : int {
+	BRUTE_FORCE = 0,
+	AABB_TREE = 1,
+	SWEEP_AND_PRUNE = 2,
+	SPATIAL_HASH = 3,
+};
+
+struct BroadPhasePair {
+	PhysicsObject* A;
+	PhysicsObject* B;
+};
+
+// The broad phase finds pairs of objects that *might* be colliding, so that only those pairs get sent through the (much more expensive)
+// narrow phase collision functions.
+//
+// NOTE: Planes are infinite, so putting them in a spatial structure would make them overlap everything. Instead they are kept in
+// their own list and tested against each body's bounds directly.
+class BroadPhase {
+public:
+	virtual ~BroadPhase() = default;
+
+	static std::unique_ptr<BroadPhase> Create(BroadPhaseType type);
+
+	// Standard deviation of the bodies' bounding radii divided by their mean. Near zero means everything is about the same size.
+	static float GetSizeVariation(const std::vector<PhysicsObject*>& objects);
+
+	void AddObject(PhysicsObject* object);
+	void RemoveObject(PhysicsObject* object);
+	void Clear();
+
+	// Fills pairs with every pair of objects whose bounds overlap this step. With speculative set, speculative bodies use bounds
+	// swept over the whole step, so they pair up with anything they could reach.
+	void UpdatePairs(float delta, std::vector<BroadPhasePair>& pairs, bool speculative = false);
+
+	// Fills results with every plane, and every body whose bounds overlapped aabb at the last UpdatePairs.
+	// NOTE: Bodies have moved since then, so pad the AABB by however far they might have gone.
+	void Query(const AABB& aabb, std::vector<PhysicsObject*>& results) const;
+
+protected:
+	virtual void AddProxy(PhysicsObject* object) = 0;
+	virtual void RemoveProxy(PhysicsObject* object) = 0;
+	virtual void ClearProxies() = 0;
+	virtual void FindPairs(float delta, std::vector<BroadPhasePair>& pairs) = 0;
+	// Checks every body's bounds by default. Broad phases with a spatial structure can do better.
+	virtual void QueryBodies(const AABB& aabb, std::vector<PhysicsObject*>& results) const;
+
+	std::vector<PhysicsObject*> m_bodies;
+	std::vector<PhysicsObject*> m_planes;
+
+	// Tight bounds for every body in m_bodies, recomputed once at the start of each update.
+	std::vector<AABB> m_aabbs;
+
+private:
+	void FindPlanePairs(std::vector<BroadPhasePair>& pairs) const;
+};
@@ -0,0 +1,10 @@
+#include "BruteForceBroadPhase.h"
+
+void BruteForceBroadPhase::FindPairs(float, std::vector<BroadPhasePair>& pairs)
+{
+	for (size_t outer = 0; outer < m_bodies.size(); outer++) {
+		for (size_t inner = outer + 1; inner < m_bodies.size(); inner++) {
+			pairs.push_back({ m_bodies[outer], m_bodies[inner] });
+		}
+	}
+}
@@ -0,0 +1,12 @@
+#pragma once
+#include "BroadPhase.h"
+
+// Tests every body against every other body, exactly like the original nested loop in PhysicsScene::Update.
+// Only really useful as a reference to check the other broad phases against.
+class BruteForceBroadPhase : public BroadPhase {
+protected:
+	void AddProxy(PhysicsObject*) override {}
+	void RemoveProxy(PhysicsObject*) override {}
+	void ClearProxies() override {}
+	void FindPairs(float, std::vector<BroadPhasePair>& pairs) override;
+};
@@ -1,18 +1,36 @@
-#pragma once 
+#pragma once
 #include "Vec2.h"
+#include <cstdint>
 #include <vector>
 
 class PhysicsObject;
 
+// Boxes resting flat on something touch along a whole edge, which takes two points to hold still.
+constexpr int MaxManifoldPoints = 2;
+
+struct ManifoldPoint {
+    Vec2 position;
+    float penetrationDepth;
+
+    // Which parts of the two shapes are touching at this point, so the same contact can be found again next step.
+    uint32_t featureID = 0;
+};
+
 struct CollisionInfo {
 
     PhysicsObject* A;
     PhysicsObject* B;
 
     bool isColliding = false;
-    float penetrationDepth;
     float elasticity;
 
+    // Shared by every point.
     Vec2 collisionNormal;
-    Vec2 collisionPoint;
+
+    ManifoldPoint points[MaxManifoldPoints];
+    int pointCount = 0;
+
+    void AddPoint(Vec2 position, float penetrationDepth, uint32_t featureID = 0) {
+        points[pointCount++] = { position, penetrationDepth, featureID };
+    }
 };
@@ -0,0 +1,55 @@
+#include "ContactCache.h"
+#include "ContactConstraint.h"
+#include "Profiler.h"
+
+size_t ContactCache::KeyHash::operator()(const Key& key) const
+{
+	// Mix in the feature, then finish off with the MurmurHash3 finaliser (like the spatial hash grid).
+	uint64_t hash = (static_cast<uint64_t>(static_cast<uint32_t>(key.A)) << 32) | static_cast<uint32_t>(key.B);
+	hash ^= static_cast<uint64_t>(key.featureID) * 0x9E3779B97F4A7C15ull;
+	hash ^= hash >> 33;
+	hash *= 0xFF51AFD7ED558CCDull;
+	hash ^= hash >> 33;
+	return static_cast<size_t>(hash);
+}
+
+ContactCache::Key ContactCache::MakeKey(const ContactConstraint& constraint, uint32_t featureID, const BodyStore& bodies)
+{
+	const BodyHandle a = bodies.GetHandle(constraint.A);
+	const BodyHandle b = bodies.GetHandle(constraint.B);
+	return (a < b) ? Key{ a, b, featureID } : Key{ b, a, featureID };
+}
+
+void ContactCache::Find(ContactConstraint& constraint, const BodyStore& bodies) const
+{
+	for (int i = 0; i < constraint.pointCount; i++) {
+		ContactPoint& point = constraint.points[i];
+
+		const auto found = m_impulses.find(MakeKey(constraint, point.featureID, bodies));
+		if (found == m_impulses.end()) continue;
+
+		point.accumulatedVelocityImpulse = found->second.normal;
+		point.accumulatedFrictionImpulse = found->second.friction;
+	}
+}
+
+void ContactCache::Store(const std::vector<ContactConstraint>& constraints, const BodyStore& bodies)
+{
+	PROFILE_ZONE("ContactCache::Store");
+
+	// NOTE: Anything that stopped touching (or went to sleep) just drops out. Clearing keeps the buckets around, so this doesn't
+	// allocate once the scene has settled.
+	m_impulses.clear();
+
+	for (const ContactConstraint& constraint : constraints) {
+		for (int i = 0; i < constraint.pointCount; i++) {
+			const ContactPoint& point = constraint.points[i];
+			m_impulses[MakeKey(constraint, point.featureID, bodies)] = { point.accumulatedVelocityImpulse, point.accumulatedFrictionImpulse };
+		}
+	}
+}
+
+void ContactCache::Clear()
+{
+	m_impulses.clear();
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include "BodyStore.h"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+struct ContactConstraint;
+
+// Remembers the impulses each contact ended up with last step, so the solver can start from there instead of from zero (warm
+// starting). Things resting on each other need roughly the same impulses every step, so most of the work is already done before
+// the first iteration.
+//
+// Each point of a contact is matched up by the handles of the two bodies and the point's feature ID (which part of each shape is
+// touching).
+// NOTE: The impulses don't change if A and B get swapped around (the normal and tangent flip too), so the pair is stored smallest
+// handle first.
+class ContactCache {
+public:
+	// Fills in the accumulated impulses of a freshly set up constraint from last step, for any of its points that existed then.
+	void Find(ContactConstraint& constraint, const BodyStore& bodies) const;
+
+	// Replaces everything in the cache with this step's contacts. Call after solving, while the body indices are still valid.
+	void Store(const std::vector<ContactConstraint>& constraints, const BodyStore& bodies);
+
+	void Clear();
+
+	[[nodiscard]] int GetSize() const { return static_cast<int>(m_impulses.size()); }
+
+private:
+	struct Key {
+		BodyHandle A;
+		BodyHandle B;
+		uint32_t featureID;
+
+		bool operator==(const Key& other) const = default;
+	};
+
+	struct KeyHash {
+		size_t operator()(const Key& key) const;
+	};
+
+	struct Impulses {
+		float normal;
+		float friction;
+	};
+
+	static Key MakeKey(const ContactConstraint& constraint, uint32_t featureID, const BodyStore& bodies);
+
+	std::unordered_map<Key, Impulses, KeyHash> m_impulses;
+};
@@ -2,92 +2,231 @@
 
 #include "ContactConstraint.h"  
 #include "PhysicsObject.h"
+#include "BodyStore.h"
 #include "CollisionInfo.h"
 #include "Maths.h"
 #include <algorithm>
 
-void ContactConstraint::Setup(CollisionInfo& info, float delta)
+void ContactConstraint::Setup(CollisionInfo& info, float delta, const BodyStore& bodies)
 {
-	A = info.A;
-	B = info.B;
+	A = info.A->GetBodyIndex();
+	B = info.B->GetBodyIndex();
 
-	collisionPoint = info.collisionPoint;
 	collisionNormal = info.collisionNormal;
+	dt = delta;
+	pointCount = info.pointCount;
 
-	rA = collisionPoint - A->GetPosition();
-	rB = collisionPoint - B->GetPosition();
-
-	accumulatedVelocityImpulse = 0.0f;
-
-	penetrationdepth = info.penetrationDepth;
+	const Vec2 tangent = Vec2(-collisionNormal.y, collisionNormal.x);
+	const float slop = 0.005f;
+	const float baumgarte = 0.3f;
 
-	rACrossN = PseudoCross(rA, collisionNormal);
-	rBCrossN = PseudoCross(rB, collisionNormal);
+	for (int i = 0; i < pointCount; i++) {
+		ContactPoint& point = points[i];
+		point.collisionPoint = info.points[i].position;
+		point.featureID = info.points[i].featureID;
+		point.penetrationdepth = info.points[i].penetrationDepth;
+
+		point.rA = point.collisionPoint - bodies.GetPosition(A);
+		point.rB = point.collisionPoint - bodies.GetPosition(B);
+
+		// NOTE: These get filled in by the contact cache if the contact was around last step.
+		point.accumulatedVelocityImpulse = 0.0f;
+		point.accumulatedFrictionImpulse = 0.0f;
+
+		point.rACrossN = PseudoCross(point.rA, collisionNormal);
+		point.rBCrossN = PseudoCross(point.rB, collisionNormal);
+
+		point.effectiveMass = 1.0f /
+						(bodies.invMass[A] + bodies.invMass[B]
+						+ (point.rACrossN * point.rACrossN * bodies.invMoment[A])
+						+ (point.rBCrossN * point.rBCrossN * bodies.invMoment[B]));
+
+		point.rACrossT = PseudoCross(point.rA, tangent);
+		point.rBCrossT = PseudoCross(point.rB, tangent);
+
+		point.effectiveMassTangent = 1.0f /
+			(bodies.invMass[A] + bodies.invMass[B]
+			+ (point.rACrossT * point.rACrossT * bodies.invMoment[A])
+			+ (point.rBCrossT * point.rBCrossT * bodies.invMoment[B]));
+
+		// NOTE: A speculative point still has a gap, so the "bias" lets the bodies keep closing at up to gap / dt. They can meet
+		// this step, but not go through each other.
+		if (point.penetrationdepth < 0.0f) point.bias = -point.penetrationdepth / delta;
+		else point.bias = -baumgarte / delta * std::max(point.penetrationdepth - slop, 0.0f);
+	}
+
+	useBlockSolver = false;
+	if (pointCount < 2) return;
+
+	const ContactPoint& point1 = points[0];
+	const ContactPoint& point2 = points[1];
+	const float invMassSum = bodies.invMass[A] + bodies.invMass[B];
+
+	k11 = invMassSum + point1.rACrossN * point1.rACrossN * bodies.invMoment[A] + point1.rBCrossN * point1.rBCrossN * bodies.invMoment[B];
+	k22 = invMassSum + point2.rACrossN * point2.rACrossN * bodies.invMoment[A] + point2.rBCrossN * point2.rBCrossN * bodies.invMoment[B];
+	k12 = invMassSum + point1.rACrossN * point2.rACrossN * bodies.invMoment[A] + point1.rBCrossN * point2.rBCrossN * bodies.invMoment[B];
+
+	// If the two points are almost on top of each other the matrix is close to singular, and inverting it would blow up. Solving
+	// them one after the other is fine in that case.
+	const float maxConditionNumber = 1000.0f;
+	const float determinant = k11 * k22 - k12 * k12;
+	if (k11 * k11 < maxConditionNumber * determinant) {
+		useBlockSolver = true;
+		inverseK11 = k22 / determinant;
+		inverseK12 = -k12 / determinant;
+		inverseK22 = k11 / determinant;
+	}
+}
 
-	effectiveMass = 1.0f / 
-					(A->GetInverseMass() + B->GetInverseMass()
-					+ (rACrossN * rACrossN * A->GetInverseMoment()) 
-					+ (rBCrossN * rBCrossN * B->GetInverseMoment()));
+bool ContactConstraint::IsSpeculative() const
+{
+	for (int i = 0; i < pointCount; i++) {
+		if (points[i].penetrationdepth >= 0.0f) return false;
+	}
+	return true;
+}
 
+void ContactConstraint::WarmStart(BodyStore& bodies)
+{
 	Vec2 tangent = Vec2(-collisionNormal.y, collisionNormal.x);
 
-	rACrossT = PseudoCross(rA, tangent);
-	rBCrossT = PseudoCross(rB, tangent);
-
-	effectiveMassTangent = 1.0f /
-		(A->GetInverseMass() + B->GetInverseMass()
-		+ (rACrossT * rACrossT * A->GetInverseMoment())
-		+ (rBCrossT * rBCrossT * B->GetInverseMoment()));
+	for (int i = 0; i < pointCount; i++) {
+		const ContactPoint& point = points[i];
+		Vec2 impulse = point.accumulatedVelocityImpulse * collisionNormal + point.accumulatedFrictionImpulse * tangent;
 
-	const float slop = 0.005f;
-	const float baumgarte = 0.3f;
-	bias = -baumgarte / delta * std::max(penetrationdepth - slop, 0.0f);
+		if (!bodies.IsStatic(A)) bodies.ApplyImpulse(A, impulse, point.collisionPoint);
+		if (!bodies.IsStatic(B)) bodies.ApplyImpulse(B, -impulse, point.collisionPoint);
+	}
 }
 
+void ContactConstraint::SolveVelocity(BodyStore& bodies)
+{
+	if (useBlockSolver) {
+		SolveBlockVelocity(bodies);
+		return;
+	}
+
+	for (int i = 0; i < pointCount; i++) {
+		SolvePointVelocity(bodies, points[i]);
+	}
+}
 
-
-void ContactConstraint::SolveVelocity()
+void ContactConstraint::SolvePointVelocity(BodyStore& bodies, ContactPoint& point)
 {
 
-	Vec2 vA = A->GetVelocity() + PseudoCross(rA, A->GetAngularVelocity());
-	Vec2 vB = B->GetVelocity() + PseudoCross(rB, B->GetAngularVelocity());
+	Vec2 vA = bodies.GetVelocity(A) + PseudoCross(point.rA, bodies.angularVelocity[A]);
+	Vec2 vB = bodies.GetVelocity(B) + PseudoCross(point.rB, bodies.angularVelocity[B]);
 	
 	Vec2 relativeVelocity = vA - vB;
 
 	float normalVelocity = Dot(relativeVelocity, collisionNormal);
 
-	float lambda = effectiveMass * (-(1 + elasticity) * normalVelocity - bias);
+	float lambda = point.effectiveMass * (-(1 + elasticity) * normalVelocity - point.bias);
 
-	float oldAccumulated = accumulatedVelocityImpulse;
-	accumulatedVelocityImpulse = std::max(oldAccumulated + lambda, 0.0f);
+	float oldAccumulated = point.accumulatedVelocityImpulse;
+	point.accumulatedVelocityImpulse = std::max(oldAccumulated + lambda, 0.0f);
 
-	lambda = accumulatedVelocityImpulse - oldAccumulated;
+	lambda = point.accumulatedVelocityImpulse - oldAccumulated;
 
-	A->ApplyImpulse(lambda * collisionNormal, collisionPoint);
-	B->ApplyImpulse(-lambda * collisionNormal, collisionPoint);
+	// NOTE: Static bodies wouldn't move anyway, but skipping them means contacts that share the ground can be solved on different
+	// threads without both writing to it.
+	if (!bodies.IsStatic(A)) bodies.ApplyImpulse(A, lambda * collisionNormal, point.collisionPoint);
+	if (!bodies.IsStatic(B)) bodies.ApplyImpulse(B, -lambda * collisionNormal, point.collisionPoint);
 
 }
 
-void ContactConstraint::SolveFriction()
+void ContactConstraint::SolveBlockVelocity(BodyStore& bodies)
+{
+	// Solving the two points one after the other makes them fight: pushing on one end of an edge tips the body onto the other end,
+	// and a box resting on its side rocks back and forth for a long time before it settles. Instead, find the pair of impulses x
+	// that gets both points to their target velocity at once, as a tiny linear complementarity problem:
+	//
+	//   w = K * x + b,  with x >= 0, w >= 0, and x_i * w_i = 0 (a point either pushes, or is separating on its own)
+	//
+	// There are only four ways that can go (both push, only one does, or neither), so just try each one until it fits.
+	ContactPoint& point1 = points[0];
+	ContactPoint& point2 = points[1];
+
+	const Vec2 vA = bodies.GetVelocity(A);
+	const Vec2 vB = bodies.GetVelocity(B);
+	const float wA = bodies.angularVelocity[A];
+	const float wB = bodies.angularVelocity[B];
+
+	const float normalVelocity1 = Dot(vA + PseudoCross(point1.rA, wA) - vB - PseudoCross(point1.rB, wB), collisionNormal);
+	const float normalVelocity2 = Dot(vA + PseudoCross(point2.rA, wA) - vB - PseudoCross(point2.rB, wB), collisionNormal);
+
+	// Same targets as the single point solve, measured from the impulses we already have.
+	const float old1 = point1.accumulatedVelocityImpulse;
+	const float old2 = point2.accumulatedVelocityImpulse;
+	const float b1 = (1 + elasticity) * normalVelocity1 + point1.bias - (k11 * old1 + k12 * old2);
+	const float b2 = (1 + elasticity) * normalVelocity2 + point2.bias - (k12 * old1 + k22 * old2);
+
+	float x1;
+	float x2;
+
+	for (;;) {
+		// Both points pushing.
+		x1 = -(inverseK11 * b1 + inverseK12 * b2);
+		x2 = -(inverseK12 * b1 + inverseK22 * b2);
+		if (x1 >= 0.0f && x2 >= 0.0f) break;
+
+		// Only the first one.
+		x1 = -b1 / k11;
+		x2 = 0.0f;
+		if (x1 >= 0.0f && k12 * x1 + b2 >= 0.0f) break;
+
+		// Only the second one.
+		x1 = 0.0f;
+		x2 = -b2 / k22;
+		if (x2 >= 0.0f && k12 * x2 + b1 >= 0.0f) break;
+
+		// Neither.
+		x1 = 0.0f;
+		x2 = 0.0f;
+		if (b1 >= 0.0f && b2 >= 0.0f) break;
+
+		// NOTE: Floating point can leave no case quite fitting. Keep last iteration's impulses rather than guessing.
+		return;
+	}
+
+	const float lambda1 = x1 - old1;
+	const float lambda2 = x2 - old2;
+	point1.accumulatedVelocityImpulse = x1;
+	point2.accumulatedVelocityImpulse = x2;
+
+	if (!bodies.IsStatic(A)) {
+		bodies.ApplyImpulse(A, lambda1 * collisionNormal, point1.collisionPoint);
+		bodies.ApplyImpulse(A, lambda2 * collisionNormal, point2.collisionPoint);
+	}
+	if (!bodies.IsStatic(B)) {
+		bodies.ApplyImpulse(B, -lambda1 * collisionNormal, point1.collisionPoint);
+		bodies.ApplyImpulse(B, -lambda2 * collisionNormal, point2.collisionPoint);
+	}
+}
+
+void ContactConstraint::SolveFriction(BodyStore& bodies)
 {
 	Vec2 tangent = Vec2(-collisionNormal.y, collisionNormal.x);
 
-	Vec2 vA = A->GetVelocity() + PseudoCross(rA, A->GetAngularVelocity());
-	Vec2 vB = B->GetVelocity() + PseudoCross(rB, B->GetAngularVelocity());
+	for (int i = 0; i < pointCount; i++) {
+		ContactPoint& point = points[i];
 
-	Vec2 relativeVelocity = vA - vB;
-	float tangentVelocity = Dot(relativeVelocity, tangent);
+		Vec2 vA = bodies.GetVelocity(A) + PseudoCross(point.rA, bodies.angularVelocity[A]);
+		Vec2 vB = bodies.GetVelocity(B) + PseudoCross(point.rB, bodies.angularVelocity[B]);
 
-	float lambda = effectiveMassTangent * (-tangentVelocity);
+		Vec2 relativeVelocity = vA - vB;
+		float tangentVelocity = Dot(relativeVelocity, tangent);
 
-	float maxFriction = 0.5f * accumulatedVelocityImpulse;
-	float oldAccumulated = accumulatedFrictionImpulse;
-	accumulatedFrictionImpulse = std::clamp(oldAccumulated + lambda, -maxFriction, maxFriction);
-	lambda = accumulatedFrictionImpulse - oldAccumulated;
+		float lambda = point.effectiveMassTangent * (-tangentVelocity);
 
-	A->ApplyImpulse(lambda * tangent, collisionPoint);
-	B->ApplyImpulse(-lambda * tangent, collisionPoint);
+		float maxFriction = 0.5f * point.accumulatedVelocityImpulse;
+		float oldAccumulated = point.accumulatedFrictionImpulse;
+		point.accumulatedFrictionImpulse = std::clamp(oldAccumulated + lambda, -maxFriction, maxFriction);
+		lambda = point.accumulatedFrictionImpulse - oldAccumulated;
 
+		if (!bodies.IsStatic(A)) bodies.ApplyImpulse(A, lambda * tangent, point.collisionPoint);
+		if (!bodies.IsStatic(B)) bodies.ApplyImpulse(B, -lambda * tangent, point.collisionPoint);
+	}
 }
 
 
@@ -1,32 +1,56 @@
 #pragma once
+#include "CollisionInfo.h"
 #include "Vec2.h"
+#include <cstdint>
 
-class PhysicsObject;
-struct CollisionInfo;
+class BodyStore;
 
-struct ContactConstraint {
-
-    PhysicsObject* A;
-    PhysicsObject* B;
-    
-    Vec2 collisionNormal;
+// Everything the solver needs for one point of a contact.
+struct ContactPoint {
     Vec2 collisionPoint;
     Vec2 rA, rB;
-    
+
     float rACrossN;
     float rBCrossN;
     float rACrossT;
     float rBCrossT;
-    float dt;
     float effectiveMass;
     float effectiveMassTangent;
     float accumulatedVelocityImpulse = 0.0f;
     float accumulatedFrictionImpulse = 0.0f;
-    float elasticity;
     float bias;
     float penetrationdepth;
+    uint32_t featureID;
+};
+
+struct ContactConstraint {
+
+    // Indices into the BodyStore arrays. These are only valid for the step the constraint was set up in.
+    int A;
+    int B;
+
+    Vec2 collisionNormal;
+    float dt;
+    float elasticity;
+
+    ContactPoint points[MaxManifoldPoints];
+    int pointCount;
+
+    // For two points, the normal impulses are solved together (see SolveVelocity). This is the 2x2 matrix of how much an impulse
+    // at each point changes the normal velocity at each point, and its inverse.
+    float k11, k12, k22;
+    float inverseK11, inverseK12, inverseK22;
+    bool useBlockSolver;
+
+	void Setup(CollisionInfo& info, float delta, const BodyStore& bodies);
+    // Not touching yet, just close enough that it could this step.
+    [[nodiscard]] bool IsSpeculative() const;
+    // Applies the impulses carried over from last step (see ContactCache) before the first iteration.
+    void WarmStart(BodyStore& bodies);
+    void SolveVelocity(BodyStore& bodies);
+    void SolveFriction(BodyStore& bodies);
 
-	void Setup(CollisionInfo& info, float delta);
-    void SolveVelocity();
-    void SolveFriction();
+private:
+    void SolvePointVelocity(BodyStore& bodies, ContactPoint& point);
+    void SolveBlockVelocity(BodyStore& bodies);
 };
@@ -0,0 +1,173 @@
+#include "ContactSolver.h"
+#include "BodyStore.h"
+#include "ContactConstraint.h"
+#include "IslandManager.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+#include <bit>
+
+// One bit per colour in the body masks, so 64 colours at most, and one extra for whatever's left over.
+constexpr int MaxColours = 64;
+constexpr int OverflowColour = MaxColours;
+
+void ContactSolver::Solve(BodyStore& bodies, std::vector<ContactConstraint>& contacts, const IslandManager& islands, JobSystem& jobs, int iterations)
+{
+	PROFILE_ZONE("ContactSolver::Solve");
+
+	m_iterations = iterations;
+	m_smallIslands.clear();
+	m_largeIslands.clear();
+	m_colourCount = 0;
+
+	for (int i = 0; i < islands.GetIslandCount(); i++) {
+		const int contactCount = static_cast<int>(islands.GetIslandContacts(i).size());
+
+		// NOTE: Most islands are a single body flying through the air, so there's nothing to solve.
+		if (contactCount == 0) continue;
+
+		// NOTE: Colouring is still worth it on one thread if the colours can be solved with SIMD.
+		if (contactCount >= LargeIslandContacts && (jobs.GetThreadCount() > 1 || m_useSimd)) m_largeIslands.push_back(i);
+		else m_smallIslands.push_back(i);
+	}
+
+	// Kick off the small islands first, so the other threads have something to chew on while this one colours the big ones.
+	JobCounter counter;
+	for (int begin = 0; begin < static_cast<int>(m_smallIslands.size()); ) {
+		// Batch tiny islands together so we're not making a job for every pair of boxes.
+		int end = begin;
+		int contactCount = 0;
+		while (end < static_cast<int>(m_smallIslands.size()) && contactCount < ColourBatchSize) {
+			contactCount += static_cast<int>(islands.GetIslandContacts(m_smallIslands[end]).size());
+			end++;
+		}
+
+		jobs.Submit([this, &bodies, &contacts, &islands, begin, end]() {
+			PROFILE_ZONE("ContactSolver::SolveIslands");
+			for (int i = begin; i < end; i++) {
+				SolveIsland(bodies, contacts, islands.GetIslandContacts(m_smallIslands[i]));
+			}
+		}, counter);
+
+		begin = end;
+	}
+
+	for (const int island : m_largeIslands) {
+		SolveLargeIsland(bodies, contacts, islands.GetIslandContacts(island), jobs);
+	}
+
+	jobs.Wait(counter);
+}
+
+void ContactSolver::SolveSerial(BodyStore& bodies, std::vector<ContactConstraint>& contacts, int iterations)
+{
+	PROFILE_ZONE("ContactSolver::SolveSerial");
+
+	for (ContactConstraint& contact : contacts) {
+		contact.WarmStart(bodies);
+	}
+
+	for (int iteration = 0; iteration < iterations; iteration++) {
+		for (ContactConstraint& contact : contacts) {
+			contact.SolveVelocity(bodies);
+			contact.SolveFriction(bodies);
+		}
+	}
+}
+
+void ContactSolver::SolveIsland(BodyStore& bodies, std::vector<ContactConstraint>& contacts, std::span<const int> island)
+{
+	for (const int index : island) {
+		contacts[index].WarmStart(bodies);
+	}
+
+	for (int iteration = 0; iteration < m_iterations; iteration++) {
+		for (const int index : island) {
+			contacts[index].SolveVelocity(bodies);
+			contacts[index].SolveFriction(bodies);
+		}
+	}
+}
+
+void ContactSolver::SolveLargeIsland(BodyStore& bodies, std::vector<ContactConstraint>& contacts, std::span<const int> island, JobSystem& jobs)
+{
+	PROFILE_ZONE("ContactSolver::SolveLargeIsland");
+
+	ColourIsland(bodies, contacts, island);
+
+	// Warm starting writes to the same bodies as solving does, so it has to go colour by colour too.
+	for (int colour = 0; colour <= OverflowColour; colour++) {
+		const int begin = m_colourStart[colour];
+		const int count = m_colourStart[colour + 1] - begin;
+		const int grainSize = (colour == OverflowColour) ? count : ColourBatchSize;
+
+		jobs.ParallelFor(count, grainSize, [this, &bodies, &contacts, begin](int first, int last) {
+			for (int i = begin + first; i < begin + last; i++) {
+				contacts[m_colouredContacts[i]].WarmStart(bodies);
+			}
+		});
+	}
+
+	for (int iteration = 0; iteration < m_iterations; iteration++) {
+		for (int colour = 0; colour < m_colourCount; colour++) {
+			const int begin = m_colourStart[colour];
+			const int count = m_colourStart[colour + 1] - begin;
+
+			jobs.ParallelFor(count, ColourBatchSize, [this, &bodies, &contacts, begin](int first, int last) {
+				PROFILE_ZONE("ContactSolver::SolveColour");
+				const int* indices = m_colouredContacts.data() + begin + first;
+				if (m_useSimd) SolveContactsSSE2(bodies, contacts, indices, last - first);
+				else SolveContactsScalar(bodies, contacts, indices, last - first);
+			});
+		}
+
+		// The leftovers can share bodies with each other, so they have to go one at a time.
+		const int overflowBegin = m_colourStart[OverflowColour];
+		SolveContactsScalar(bodies, contacts, m_colouredContacts.data() + overflowBegin, m_colourStart[OverflowColour + 1] - overflowBegin);
+	}
+}
+
+void ContactSolver::ColourIsland(const BodyStore& bodies, const std::vector<ContactConstraint>& contacts, std::span<const int> island)
+{
+	PROFILE_ZONE("ContactSolver::ColourIsland");
+
+	if (static_cast<int>(m_bodyColours.size()) < bodies.GetCount()) m_bodyColours.resize(bodies.GetCount());
+
+	for (const int index : island) {
+		m_bodyColours[contacts[index].A] = 0;
+		m_bodyColours[contacts[index].B] = 0;
+	}
+
+	// Greedy colouring: every contact takes the first colour neither of its bodies has been used in yet.
+	// NOTE: Static bodies are left out, since nothing writes to them. Otherwise everything on the ground would need its own colour.
+	m_contactColour.resize(island.size());
+	m_colourStart.assign(MaxColours + 2, 0);
+	m_colourCount = 0;
+
+	for (int i = 0; i < static_cast<int>(island.size()); i++) {
+		const ContactConstraint& contact = contacts[island[i]];
+		const uint64_t maskA = bodies.IsStatic(contact.A) ? 0 : m_bodyColours[contact.A];
+		const uint64_t maskB = bodies.IsStatic(contact.B) ? 0 : m_bodyColours[contact.B];
+
+		const int colour = std::countr_one(maskA | maskB);
+		m_contactColour[i] = colour;
+		m_colourStart[colour + 1]++;
+
+		if (colour == OverflowColour) continue;
+
+		const uint64_t bit = uint64_t(1) << colour;
+		if (!bodies.IsStatic(contact.A)) m_bodyColours[contact.A] |= bit;
+		if (!bodies.IsStatic(contact.B)) m_bodyColours[contact.B] |= bit;
+		if (colour + 1 > m_colourCount) m_colourCount = colour + 1;
+	}
+
+	for (int i = 0; i < MaxColours + 1; i++) {
+		m_colourStart[i + 1] += m_colourStart[i];
+	}
+
+	// Counting sort by colour, keeping the original order within each colour.
+	m_colouredContacts.resize(island.size());
+	m_colourCursor.assign(m_colourStart.begin(), m_colourStart.end() - 1);
+	for (int i = 0; i < static_cast<int>(island.size()); i++) {
+		m_colouredContacts[m_colourCursor[m_contactColour[i]]++] = island[i];
+	}
+}
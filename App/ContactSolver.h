@@ -0,0 +1,84 @@
+#pragma once
+#include "ContactConstraint.h"
+#include <cstdint>
+#include <span>
+#include <vector>
+
+class BodyStore;
+class IslandManager;
+class JobSystem;
+
+// Islands with at least this many contacts get split up with graph colouring instead of being solved on one thread.
+constexpr int LargeIslandContacts = 256;
+
+// How many contacts each job in a colour gets.
+constexpr int ColourBatchSize = 64;
+
+// Solves the contact constraints across every thread in the job system. Islands don't share any moving bodies, so each one is
+// solved as its own job, and solving an island with the same contacts in the same order gives the same answer no matter which
+// thread it ends up on.
+//
+// One big pile is a single island though, so large islands get split with graph colouring: contacts are given colours so that no
+// two contacts with the same colour touch the same (non-static) body, which means every contact in a colour can be solved at the
+// same time. The colours themselves still have to go one after another.
+//
+// Contacts within a colour are also independent of each other, so they can be solved 4 at a time in SSE2 lanes. Each lane gathers
+// its contact and bodies, does exactly what ContactConstraint does, and scatters the results back. Single point contacts and two
+// point contacts (boxes lying flat) are batched separately, since the two point ones go through the block solver.
+//
+// NOTE: Colouring changes the order the contacts in a large island are solved in, so large islands converge slightly differently to
+// the single threaded solver. The answer is still deterministic for a given set of contacts, since the colouring doesn't depend on
+// how many threads there are.
+class ContactSolver {
+public:
+	// Warm starts every contact, then runs the given number of velocity iterations.
+	void Solve(BodyStore& bodies, std::vector<ContactConstraint>& contacts, const IslandManager& islands, JobSystem& jobs, int iterations);
+
+	// Solves every contact in order on the calling thread. This is what the solver did before it went wide.
+	void SolveSerial(BodyStore& bodies, std::vector<ContactConstraint>& contacts, int iterations);
+
+	[[nodiscard]] bool GetSimd() const { return m_useSimd; }
+	void SetSimd(bool useSimd) { m_useSimd = useSimd; }
+
+	[[nodiscard]] int GetLargeIslandCount() const { return static_cast<int>(m_largeIslands.size()); }
+	[[nodiscard]] int GetColourCount() const { return m_colourCount; }
+
+private:
+	void SolveIsland(BodyStore& bodies, std::vector<ContactConstraint>& contacts, std::span<const int> island);
+	void SolveLargeIsland(BodyStore& bodies, std::vector<ContactConstraint>& contacts, std::span<const int> island, JobSystem& jobs);
+	void ColourIsland(const BodyStore& bodies, const std::vector<ContactConstraint>& contacts, std::span<const int> island);
+
+	int m_iterations = 0;
+
+	std::vector<int> m_smallIslands;
+	std::vector<int> m_largeIslands;
+
+	// Which colours each body has already been used in, one bit per colour.
+	std::vector<uint64_t> m_bodyColours;
+
+	// The contacts in the island being solved, sorted by colour. Colour i is m_colouredContacts[m_colourStart[i]] up to
+	// m_colouredContacts[m_colourStart[i + 1]]. The last colour is for contacts that didn't fit in any of the others, and gets
+	// solved on one thread.
+	std::vector<int> m_colourStart;
+	std::vector<int> m_colouredContacts;
+	std::vector<int> m_contactColour;
+	std::vector<int> m_colourCursor;
+	int m_colourCount = 0;
+
+#if defined(PHYSICS_HAS_SSE2)
+	bool m_useSimd = true;
+#else
+	bool m_useSimd = false;
+#endif
+};
+
+// Solves each of the given contacts once, 4 at a time. None of the contacts can share a (non-static) body.
+void SolveContactsSSE2(BodyStore& bodies, std::vector<ContactConstraint>& contacts, const int* indices, int count);
+
+inline void SolveContactsScalar(BodyStore& bodies, std::vector<ContactConstraint>& contacts, const int* indices, int count)
+{
+	for (int i = 0; i < count; i++) {
+		contacts[indices[i]].SolveVelocity(bodies);
+		contacts[indices[i]].SolveFriction(bodies);
+	}
+}
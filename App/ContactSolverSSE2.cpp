@@ -0,0 +1,303 @@
+#include "ContactSolver.h"
+#include "BodyStore.h"
+#include "ContactConstraint.h"
+
+#if defined(PHYSICS_HAS_SSE2)
+#include <emmintrin.h>
+
+namespace {
+
+// One body per lane, gathered out of the BodyStore.
+struct BodyLanes {
+	__m128 velocityX, velocityY, angularVelocity;
+	__m128 positionX, positionY;
+	__m128 invMass, invMoment;
+};
+
+BodyLanes GatherBodies(const BodyStore& bodies, const int* index)
+{
+	BodyLanes lanes;
+	lanes.velocityX = _mm_setr_ps(bodies.velocityX[index[0]], bodies.velocityX[index[1]], bodies.velocityX[index[2]], bodies.velocityX[index[3]]);
+	lanes.velocityY = _mm_setr_ps(bodies.velocityY[index[0]], bodies.velocityY[index[1]], bodies.velocityY[index[2]], bodies.velocityY[index[3]]);
+	lanes.angularVelocity = _mm_setr_ps(bodies.angularVelocity[index[0]], bodies.angularVelocity[index[1]], bodies.angularVelocity[index[2]], bodies.angularVelocity[index[3]]);
+	lanes.positionX = _mm_setr_ps(bodies.positionX[index[0]], bodies.positionX[index[1]], bodies.positionX[index[2]], bodies.positionX[index[3]]);
+	lanes.positionY = _mm_setr_ps(bodies.positionY[index[0]], bodies.positionY[index[1]], bodies.positionY[index[2]], bodies.positionY[index[3]]);
+	lanes.invMass = _mm_setr_ps(bodies.invMass[index[0]], bodies.invMass[index[1]], bodies.invMass[index[2]], bodies.invMass[index[3]]);
+	lanes.invMoment = _mm_setr_ps(bodies.invMoment[index[0]], bodies.invMoment[index[1]], bodies.invMoment[index[2]], bodies.invMoment[index[3]]);
+	return lanes;
+}
+
+// NOTE: Static bodies are skipped, same as ContactConstraint, since the ground can show up in several lanes (and several threads) at once.
+void ScatterBodies(BodyStore& bodies, const int* index, const BodyLanes& lanes)
+{
+	alignas(16) float velocityX[4];
+	alignas(16) float velocityY[4];
+	alignas(16) float angularVelocity[4];
+	_mm_store_ps(velocityX, lanes.velocityX);
+	_mm_store_ps(velocityY, lanes.velocityY);
+	_mm_store_ps(angularVelocity, lanes.angularVelocity);
+
+	for (int lane = 0; lane < 4; lane++) {
+		if (bodies.IsStatic(index[lane])) continue;
+		bodies.velocityX[index[lane]] = velocityX[lane];
+		bodies.velocityY[index[lane]] = velocityY[lane];
+		bodies.angularVelocity[index[lane]] = angularVelocity[lane];
+	}
+}
+
+// Same as BodyStore::ApplyImpulse.
+void ApplyImpulse(BodyLanes& body, __m128 impulseX, __m128 impulseY, __m128 pointX, __m128 pointY)
+{
+	body.velocityX = _mm_add_ps(body.velocityX, _mm_mul_ps(impulseX, body.invMass));
+	body.velocityY = _mm_add_ps(body.velocityY, _mm_mul_ps(impulseY, body.invMass));
+
+	const __m128 rX = _mm_sub_ps(pointX, body.positionX);
+	const __m128 rY = _mm_sub_ps(pointY, body.positionY);
+	const __m128 cross = _mm_sub_ps(_mm_mul_ps(rX, impulseY), _mm_mul_ps(rY, impulseX));
+	body.angularVelocity = _mm_add_ps(body.angularVelocity, _mm_mul_ps(cross, body.invMoment));
+}
+
+// The velocity of the point r away from the body's centre, along the given direction.
+__m128 RelativeVelocity(const BodyLanes& a, __m128 rAX, __m128 rAY, const BodyLanes& b, __m128 rBX, __m128 rBY, __m128 directionX, __m128 directionY)
+{
+	const __m128 vAX = _mm_sub_ps(a.velocityX, _mm_mul_ps(a.angularVelocity, rAY));
+	const __m128 vAY = _mm_add_ps(a.velocityY, _mm_mul_ps(a.angularVelocity, rAX));
+	const __m128 vBX = _mm_sub_ps(b.velocityX, _mm_mul_ps(b.angularVelocity, rBY));
+	const __m128 vBY = _mm_add_ps(b.velocityY, _mm_mul_ps(b.angularVelocity, rBX));
+
+	return _mm_add_ps(_mm_mul_ps(_mm_sub_ps(vAX, vBX), directionX), _mm_mul_ps(_mm_sub_ps(vAY, vBY), directionY));
+}
+
+// One contact point in each lane.
+struct PointLanes {
+	__m128 pointX, pointY;
+	__m128 rAX, rAY, rBX, rBY;
+};
+
+// Applies the impulse along direction to A at each lane's point, and the opposite to B.
+void ApplyPointImpulse(BodyLanes& a, BodyLanes& b, const PointLanes& point, __m128 directionX, __m128 directionY, __m128 lambda)
+{
+	const __m128 negativeLambda = _mm_xor_ps(lambda, _mm_set1_ps(-0.0f));
+	ApplyImpulse(a, _mm_mul_ps(directionX, lambda), _mm_mul_ps(directionY, lambda), point.pointX, point.pointY);
+	ApplyImpulse(b, _mm_mul_ps(directionX, negativeLambda), _mm_mul_ps(directionY, negativeLambda), point.pointX, point.pointY);
+}
+
+// Friction at one point. See ContactConstraint::SolveFriction. Returns the new accumulated friction impulse.
+__m128 SolveFriction(BodyLanes& a, BodyLanes& b, const PointLanes& point, __m128 normalX, __m128 normalY,
+					 __m128 effectiveMassTangent, __m128 accumulatedNormal, __m128 oldFriction)
+{
+	const __m128 signBit = _mm_set1_ps(-0.0f);
+	const __m128 tangentX = _mm_xor_ps(normalY, signBit);
+	const __m128 tangentY = normalX;
+
+	const __m128 tangentVelocity = RelativeVelocity(a, point.rAX, point.rAY, b, point.rBX, point.rBY, tangentX, tangentY);
+	__m128 lambda = _mm_mul_ps(effectiveMassTangent, _mm_xor_ps(tangentVelocity, signBit));
+
+	const __m128 maxFriction = _mm_mul_ps(_mm_set1_ps(0.5f), accumulatedNormal);
+	const __m128 accumulatedFriction = _mm_max_ps(_mm_xor_ps(maxFriction, signBit), _mm_min_ps(maxFriction, _mm_add_ps(oldFriction, lambda)));
+	lambda = _mm_sub_ps(accumulatedFriction, oldFriction);
+
+	ApplyPointImpulse(a, b, point, tangentX, tangentY, lambda);
+	return accumulatedFriction;
+}
+
+// mask ? ifTrue : ifFalse, per lane.
+__m128 Select(__m128 mask, __m128 ifTrue, __m128 ifFalse)
+{
+	return _mm_or_ps(_mm_and_ps(mask, ifTrue), _mm_andnot_ps(mask, ifFalse));
+}
+
+void StoreImpulses(ContactPoint& point, float normalImpulse, float frictionImpulse)
+{
+	point.accumulatedVelocityImpulse = normalImpulse;
+	point.accumulatedFrictionImpulse = frictionImpulse;
+}
+
+#define GATHER_CONTACTS(FIELD) _mm_setr_ps(c0.FIELD, c1.FIELD, c2.FIELD, c3.FIELD)
+#define GATHER_POINT(POINT) PointLanes{ \
+	GATHER_CONTACTS(points[POINT].collisionPoint.x), GATHER_CONTACTS(points[POINT].collisionPoint.y), \
+	GATHER_CONTACTS(points[POINT].rA.x), GATHER_CONTACTS(points[POINT].rA.y), \
+	GATHER_CONTACTS(points[POINT].rB.x), GATHER_CONTACTS(points[POINT].rB.y) }
+
+// Four single point contacts.
+void SolveLanes(BodyStore& bodies, std::vector<ContactConstraint>& contacts, const int* indices)
+{
+	ContactConstraint& c0 = contacts[indices[0]];
+	ContactConstraint& c1 = contacts[indices[1]];
+	ContactConstraint& c2 = contacts[indices[2]];
+	ContactConstraint& c3 = contacts[indices[3]];
+
+	const int indexA[4] = { c0.A, c1.A, c2.A, c3.A };
+	const int indexB[4] = { c0.B, c1.B, c2.B, c3.B };
+	BodyLanes a = GatherBodies(bodies, indexA);
+	BodyLanes b = GatherBodies(bodies, indexB);
+
+	const __m128 normalX = GATHER_CONTACTS(collisionNormal.x);
+	const __m128 normalY = GATHER_CONTACTS(collisionNormal.y);
+	const PointLanes point = GATHER_POINT(0);
+
+	// Normal impulse. See ContactConstraint::SolvePointVelocity.
+	const __m128 normalVelocity = RelativeVelocity(a, point.rAX, point.rAY, b, point.rBX, point.rBY, normalX, normalY);
+	const __m128 restitution = _mm_xor_ps(_mm_add_ps(_mm_set1_ps(1.0f), GATHER_CONTACTS(elasticity)), _mm_set1_ps(-0.0f));
+	const __m128 lambda = _mm_mul_ps(GATHER_CONTACTS(points[0].effectiveMass), _mm_sub_ps(_mm_mul_ps(restitution, normalVelocity), GATHER_CONTACTS(points[0].bias)));
+
+	// NOTE: The argument order of the min/max calls matters, so that ties pick the same value std::max and std::clamp would.
+	const __m128 oldNormal = GATHER_CONTACTS(points[0].accumulatedVelocityImpulse);
+	const __m128 accumulatedNormal = _mm_max_ps(_mm_setzero_ps(), _mm_add_ps(oldNormal, lambda));
+	ApplyPointImpulse(a, b, point, normalX, normalY, _mm_sub_ps(accumulatedNormal, oldNormal));
+
+	const __m128 accumulatedFriction = SolveFriction(a, b, point, normalX, normalY, GATHER_CONTACTS(points[0].effectiveMassTangent),
+													 accumulatedNormal, GATHER_CONTACTS(points[0].accumulatedFrictionImpulse));
+
+	ScatterBodies(bodies, indexA, a);
+	ScatterBodies(bodies, indexB, b);
+
+	alignas(16) float normalImpulse[4];
+	alignas(16) float frictionImpulse[4];
+	_mm_store_ps(normalImpulse, accumulatedNormal);
+	_mm_store_ps(frictionImpulse, accumulatedFriction);
+
+	StoreImpulses(c0.points[0], normalImpulse[0], frictionImpulse[0]);
+	StoreImpulses(c1.points[0], normalImpulse[1], frictionImpulse[1]);
+	StoreImpulses(c2.points[0], normalImpulse[2], frictionImpulse[2]);
+	StoreImpulses(c3.points[0], normalImpulse[3], frictionImpulse[3]);
+}
+
+// Four two point contacts that use the block solver.
+void SolveManifoldLanes(BodyStore& bodies, std::vector<ContactConstraint>& contacts, const int* indices)
+{
+	ContactConstraint& c0 = contacts[indices[0]];
+	ContactConstraint& c1 = contacts[indices[1]];
+	ContactConstraint& c2 = contacts[indices[2]];
+	ContactConstraint& c3 = contacts[indices[3]];
+
+	const int indexA[4] = { c0.A, c1.A, c2.A, c3.A };
+	const int indexB[4] = { c0.B, c1.B, c2.B, c3.B };
+	BodyLanes a = GatherBodies(bodies, indexA);
+	BodyLanes b = GatherBodies(bodies, indexB);
+
+	const __m128 normalX = GATHER_CONTACTS(collisionNormal.x);
+	const __m128 normalY = GATHER_CONTACTS(collisionNormal.y);
+	const PointLanes point1 = GATHER_POINT(0);
+	const PointLanes point2 = GATHER_POINT(1);
+
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 signBit = _mm_set1_ps(-0.0f);
+
+	// Normal impulses. See ContactConstraint::SolveBlockVelocity.
+	const __m128 k11 = GATHER_CONTACTS(k11);
+	const __m128 k12 = GATHER_CONTACTS(k12);
+	const __m128 k22 = GATHER_CONTACTS(k22);
+	const __m128 inverseK11 = GATHER_CONTACTS(inverseK11);
+	const __m128 inverseK12 = GATHER_CONTACTS(inverseK12);
+	const __m128 inverseK22 = GATHER_CONTACTS(inverseK22);
+
+	const __m128 normalVelocity1 = RelativeVelocity(a, point1.rAX, point1.rAY, b, point1.rBX, point1.rBY, normalX, normalY);
+	const __m128 normalVelocity2 = RelativeVelocity(a, point2.rAX, point2.rAY, b, point2.rBX, point2.rBY, normalX, normalY);
+	const __m128 restitution = _mm_add_ps(_mm_set1_ps(1.0f), GATHER_CONTACTS(elasticity));
+
+	const __m128 old1 = GATHER_CONTACTS(points[0].accumulatedVelocityImpulse);
+	const __m128 old2 = GATHER_CONTACTS(points[1].accumulatedVelocityImpulse);
+	const __m128 b1 = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(restitution, normalVelocity1), GATHER_CONTACTS(points[0].bias)),
+								 _mm_add_ps(_mm_mul_ps(k11, old1), _mm_mul_ps(k12, old2)));
+	const __m128 b2 = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(restitution, normalVelocity2), GATHER_CONTACTS(points[1].bias)),
+								 _mm_add_ps(_mm_mul_ps(k12, old1), _mm_mul_ps(k22, old2)));
+
+	// Work out all four cases in every lane, then take the first one that fits. Lanes where nothing fits keep their impulses.
+	const __m128 bothX1 = _mm_xor_ps(_mm_add_ps(_mm_mul_ps(inverseK11, b1), _mm_mul_ps(inverseK12, b2)), signBit);
+	const __m128 bothX2 = _mm_xor_ps(_mm_add_ps(_mm_mul_ps(inverseK12, b1), _mm_mul_ps(inverseK22, b2)), signBit);
+	const __m128 bothFits = _mm_and_ps(_mm_cmpge_ps(bothX1, zero), _mm_cmpge_ps(bothX2, zero));
+
+	const __m128 firstX1 = _mm_div_ps(_mm_xor_ps(b1, signBit), k11);
+	const __m128 firstFits = _mm_and_ps(_mm_cmpge_ps(firstX1, zero), _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(k12, firstX1), b2), zero));
+
+	const __m128 secondX2 = _mm_div_ps(_mm_xor_ps(b2, signBit), k22);
+	const __m128 secondFits = _mm_and_ps(_mm_cmpge_ps(secondX2, zero), _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(k12, secondX2), b1), zero));
+
+	const __m128 neitherFits = _mm_and_ps(_mm_cmpge_ps(b1, zero), _mm_cmpge_ps(b2, zero));
+
+	__m128 x1 = Select(neitherFits, zero, old1);
+	__m128 x2 = Select(neitherFits, zero, old2);
+	x1 = Select(secondFits, zero, x1);
+	x2 = Select(secondFits, secondX2, x2);
+	x1 = Select(firstFits, firstX1, x1);
+	x2 = Select(firstFits, zero, x2);
+	x1 = Select(bothFits, bothX1, x1);
+	x2 = Select(bothFits, bothX2, x2);
+
+	ApplyPointImpulse(a, b, point1, normalX, normalY, _mm_sub_ps(x1, old1));
+	ApplyPointImpulse(a, b, point2, normalX, normalY, _mm_sub_ps(x2, old2));
+
+	const __m128 friction1 = SolveFriction(a, b, point1, normalX, normalY, GATHER_CONTACTS(points[0].effectiveMassTangent),
+										   x1, GATHER_CONTACTS(points[0].accumulatedFrictionImpulse));
+	const __m128 friction2 = SolveFriction(a, b, point2, normalX, normalY, GATHER_CONTACTS(points[1].effectiveMassTangent),
+										   x2, GATHER_CONTACTS(points[1].accumulatedFrictionImpulse));
+
+	ScatterBodies(bodies, indexA, a);
+	ScatterBodies(bodies, indexB, b);
+
+	alignas(16) float normalImpulse1[4];
+	alignas(16) float normalImpulse2[4];
+	alignas(16) float frictionImpulse1[4];
+	alignas(16) float frictionImpulse2[4];
+	_mm_store_ps(normalImpulse1, x1);
+	_mm_store_ps(normalImpulse2, x2);
+	_mm_store_ps(frictionImpulse1, friction1);
+	_mm_store_ps(frictionImpulse2, friction2);
+
+	ContactConstraint* lanes[4] = { &c0, &c1, &c2, &c3 };
+	for (int lane = 0; lane < 4; lane++) {
+		StoreImpulses(lanes[lane]->points[0], normalImpulse1[lane], frictionImpulse1[lane]);
+		StoreImpulses(lanes[lane]->points[1], normalImpulse2[lane], frictionImpulse2[lane]);
+	}
+}
+
+#undef GATHER_POINT
+#undef GATHER_CONTACTS
+
+}
+
+void SolveContactsSSE2(BodyStore& bodies, std::vector<ContactConstraint>& contacts, const int* indices, int count)
+{
+	// NOTE: Single point contacts and block solved manifolds take different paths, so they're batched up separately. None of the
+	// contacts share a body, so the order doesn't change the answer.
+	int singles[4];
+	int manifolds[4];
+	int singleCount = 0;
+	int manifoldCount = 0;
+
+	for (int i = 0; i < count; i++) {
+		const ContactConstraint& contact = contacts[indices[i]];
+
+		if (contact.pointCount == 1) {
+			singles[singleCount++] = indices[i];
+			if (singleCount == 4) {
+				SolveLanes(bodies, contacts, singles);
+				singleCount = 0;
+			}
+		}
+		else if (contact.useBlockSolver) {
+			manifolds[manifoldCount++] = indices[i];
+			if (manifoldCount == 4) {
+				SolveManifoldLanes(bodies, contacts, manifolds);
+				manifoldCount = 0;
+			}
+		}
+		else {
+			SolveContactsScalar(bodies, contacts, indices + i, 1);
+		}
+	}
+
+	SolveContactsScalar(bodies, contacts, singles, singleCount);
+	SolveContactsScalar(bodies, contacts, manifolds, manifoldCount);
+}
+
+#else
+
+// NOTE: Not an x86 build, so ContactSolver never picks this path. This only exists so everything still links.
+void SolveContactsSSE2(BodyStore& bodies, std::vector<ContactConstraint>& contacts, const int* indices, int count)
+{
+	SolveContactsScalar(bodies, contacts, indices, count);
+}
+
+#endif
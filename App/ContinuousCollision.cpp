@@ -0,0 +1,172 @@
+#include "ContinuousCollision.h"
+#include "Box.h"
+#include "Circle.h"
+#include "Plane.h"
+#include <cfloat>
+#include <cmath>
+
+ShapePose ShapePose::FromObject(const PhysicsObject* object)
+{
+	return FromObject(object, object->GetPosition(), object->GetOrientation());
+}
+
+ShapePose ShapePose::FromObject(const PhysicsObject* object, Vec2 position, float orientation)
+{
+	ShapePose pose;
+	pose.type = object->m_ShapeID;
+	pose.position = position;
+
+	switch (object->m_ShapeID) {
+	case ShapeType::PLANE: {
+		const Plane* plane = static_cast<const Plane*>(object);
+		pose.normal = plane->GetNormal();
+		pose.distance = plane->GetDistance();
+		break;
+	}
+	case ShapeType::CIRCLE:
+		pose.radius = static_cast<const Circle*>(object)->GetRadius();
+		break;
+	case ShapeType::BOX: {
+		const Box* box = static_cast<const Box*>(object);
+		pose.halfExtents = { box->GetHalfWidth(), box->GetHalfHeight() };
+		// NOTE: Worked out here rather than using the box's cached axes, since the pose usually isn't where the box is.
+		pose.xAxis = Vec2{ 1.0f, 0.0f }.RotateBy(orientation);
+		pose.yAxis = Vec2{ 0.0f, 1.0f }.RotateBy(orientation);
+		break;
+	}
+	}
+	return pose;
+}
+
+float ShapePose::GetBoundingRadius() const
+{
+	if (type == ShapeType::BOX) return halfExtents.GetMagnitude();
+	return radius;
+}
+
+// Half the box's width along the axis.
+static float ProjectBox(const ShapePose& box, Vec2 axis)
+{
+	return box.halfExtents.x * abs(Dot(box.xAxis, axis)) + box.halfExtents.y * abs(Dot(box.yAxis, axis));
+}
+
+static Separation ShapeToPlane(const ShapePose& A, const ShapePose& plane)
+{
+	// NOTE: Planes are two-sided, the same as in the collision functions, so measure from whichever side the shape is on.
+	const float centreDistance = Dot(A.position, plane.normal) - plane.distance;
+	const Vec2 normal = centreDistance >= 0.0f ? plane.normal : -plane.normal;
+	const float r = A.type == ShapeType::BOX ? ProjectBox(A, normal) : A.radius;
+
+	return { abs(centreDistance) - r, normal };
+}
+
+static Separation CircleToCircle(const ShapePose& A, const ShapePose& B)
+{
+	const Vec2 offset = A.position - B.position;
+	const float length = offset.GetMagnitude();
+	const Vec2 normal = length > FLT_EPSILON ? offset / length : Vec2{ 0.0f, 1.0f };
+
+	return { length - A.radius - B.radius, normal };
+}
+
+static Separation CircleToBox(const ShapePose& circle, const ShapePose& box)
+{
+	// The same as Sphere2Box, in the box's local space.
+	const Vec2 relative = circle.position - box.position;
+	const Vec2 local = { Dot(relative, box.xAxis), Dot(relative, box.yAxis) };
+	const Vec2 closest = { Clamp<float>(local.x, -box.halfExtents.x, box.halfExtents.x),
+						   Clamp<float>(local.y, -box.halfExtents.y, box.halfExtents.y) };
+
+	const Vec2 offset = local - closest;
+	const float length = offset.GetMagnitude();
+
+	if (length > FLT_EPSILON) {
+		const Vec2 normal = box.xAxis * (offset.x / length) + box.yAxis * (offset.y / length);
+		return { length - circle.radius, normal };
+	}
+
+	// The centre is inside the box, so push it out through the nearest face.
+	const float xDepth = box.halfExtents.x - abs(local.x);
+	const float yDepth = box.halfExtents.y - abs(local.y);
+	if (xDepth < yDepth) return { -xDepth - circle.radius, local.x >= 0.0f ? box.xAxis : -box.xAxis };
+	return { -yDepth - circle.radius, local.y >= 0.0f ? box.yAxis : -box.yAxis };
+}
+
+static Separation BoxToBox(const ShapePose& A, const ShapePose& B)
+{
+	const Vec2 axes[4] = { A.xAxis, A.yAxis, B.xAxis, B.yAxis };
+	const Vec2 offset = A.position - B.position;
+
+	Separation best = { -FLT_MAX, { 0.0f, 1.0f } };
+	for (const Vec2 axis : axes) {
+		const float distance = Dot(offset, axis);
+		const float gap = abs(distance) - ProjectBox(A, axis) - ProjectBox(B, axis);
+		if (gap > best.distance) {
+			best.distance = gap;
+			best.normal = distance >= 0.0f ? axis : -axis;
+		}
+	}
+	return best;
+}
+
+Separation GetSeparation(const ShapePose& A, const ShapePose& B)
+{
+	if (A.type == ShapeType::PLANE && B.type == ShapeType::PLANE) return { FLT_MAX, { 0.0f, 1.0f } };
+
+	// Flip the pair around so A is never the plane, and the box always comes second out of a box and a circle.
+	if (A.type == ShapeType::PLANE || (A.type == ShapeType::BOX && B.type == ShapeType::CIRCLE)) {
+		const Separation flipped = GetSeparation(B, A);
+		return { flipped.distance, -flipped.normal };
+	}
+
+	if (B.type == ShapeType::PLANE) return ShapeToPlane(A, B);
+	if (A.type == ShapeType::CIRCLE && B.type == ShapeType::CIRCLE) return CircleToCircle(A, B);
+	if (A.type == ShapeType::CIRCLE) return CircleToBox(A, B);
+	return BoxToBox(A, B);
+}
+
+float TimeOfImpact(const PhysicsObject* object, const Sweep& sweep, const ShapePose& other)
+{
+	constexpr int MaxIterations = 20;
+
+	Separation separation = GetSeparation(ShapePose::FromObject(object, sweep.startPosition, sweep.startOrientation), other);
+	if (separation.distance <= 0.0f) return 1.0f;
+
+	// NOTE: Nothing on the body can move further than this from turning, however the turn lines up with the normal.
+	const Vec2 translation = sweep.endPosition - sweep.startPosition;
+	const float rotationBound = abs(sweep.endOrientation - sweep.startOrientation) * ShapePose::FromObject(object).GetBoundingRadius();
+
+	// Anything in (-2 * target, 0] counts as just touching.
+	const float deepest = -2.0f * TimeOfImpactTarget;
+
+	float t = 0.0f;
+	for (int iteration = 0; iteration < MaxIterations; iteration++) {
+
+		// How fast the gap can possibly be closing, per unit of t.
+		const float approachSpeed = rotationBound - Dot(translation, separation.normal);
+		if (approachSpeed <= FLT_EPSILON) return 1.0f;
+
+		const float lastT = t;
+		t += (separation.distance + TimeOfImpactTarget) / approachSpeed;
+		if (t >= 1.0f) return 1.0f;
+
+		separation = GetSeparation(ShapePose::FromObject(object, sweep.GetPosition(t), sweep.GetOrientation(t)), other);
+		if (separation.distance > 0.0f) continue;
+		if (separation.distance >= deepest) return t;
+
+		// The normal turned during the step (e.g. rounding a corner), so we went too far. Bisect back to the band instead.
+		float low = lastT;
+		float high = t;
+		for (int bisection = 0; bisection < MaxIterations; bisection++) {
+			const float middle = 0.5f * (low + high);
+			const float distance = GetSeparation(ShapePose::FromObject(object, sweep.GetPosition(middle), sweep.GetOrientation(middle)), other).distance;
+			if (distance > 0.0f) low = middle;
+			else if (distance < deepest) high = middle;
+			else return middle;
+		}
+		return low;
+	}
+
+	// NOTE: Ran out of iterations still short of the other object, which is at least somewhere safe to stop.
+	return t;
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include "PhysicsObject.h"
+#include "Vec2.h"
+
+// One shape frozen at a particular pose. The time of impact search moves these around without touching the BodyStore.
+struct ShapePose {
+	ShapeType type;
+	Vec2 position;
+	Vec2 xAxis = { 1.0f, 0.0f };
+	Vec2 yAxis = { 0.0f, 1.0f };
+
+	// Half width and height for boxes, radius for circles, (normal, distance) for planes.
+	Vec2 halfExtents;
+	float radius = 0.0f;
+	Vec2 normal;
+	float distance = 0.0f;
+
+	// Where the object is right now.
+	static ShapePose FromObject(const PhysicsObject* object);
+	// Same shape as the object, but at the given position and orientation.
+	static ShapePose FromObject(const PhysicsObject* object, Vec2 position, float orientation);
+
+	// Furthest any point on the shape is from its centre, which bounds how fast rotation can move it.
+	[[nodiscard]] float GetBoundingRadius() const;
+};
+
+// Roughly how far apart two shapes are, and which way. Negative means they're overlapping.
+// NOTE: For two boxes this is the biggest gap along any of their axes, which is never more than the real distance and only
+// reaches zero when they touch. That's all the time of impact search needs.
+struct Separation {
+	float distance;
+	// Points from B towards A.
+	Vec2 normal;
+};
+
+Separation GetSeparation(const ShapePose& A, const ShapePose& B);
+
+// A body moving in a straight line (and turning at a constant rate) over one step. t goes from 0 at the start to 1 at the end.
+struct Sweep {
+	Vec2 startPosition;
+	Vec2 endPosition;
+	float startOrientation;
+	float endOrientation;
+
+	[[nodiscard]] Vec2 GetPosition(float t) const { return startPosition + t * (endPosition - startPosition); }
+	[[nodiscard]] float GetOrientation(float t) const { return startOrientation + t * (endOrientation - startOrientation); }
+};
+
+// How far past touching the search tries to stop, so the normal collision functions will pick the contact up.
+constexpr float TimeOfImpactTarget = 0.0025f;
+
+// Conservative advancement: moves the swept object forward as far as it can go without closing the gap faster than its speed
+// allows, until it is just touching the other (fixed) object. Returns 1 if they never touch during the sweep.
+//
+// NOTE: Pairs that already overlap at the start are left to the normal contacts, so this also returns 1 for them.
+float TimeOfImpact(const PhysicsObject* object, const Sweep& sweep, const ShapePose& other);
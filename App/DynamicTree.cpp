@@ -0,0 +1,301 @@
+#include "DynamicTree.h"
+
+// How far ahead (in steps) the fattened bounds are stretched in the direction an object is moving.
+constexpr float DisplacementMultiplier = 2.0f;
+
+DynamicTree::DynamicTree()
+{
+	m_queryStack.reserve(256);
+}
+
+int DynamicTree::CreateProxy(const AABB& aabb, PhysicsObject* object)
+{
+	const int proxyID = AllocateNode();
+
+	m_nodes[proxyID].aabb = Fatten(aabb, { 0.0f, 0.0f });
+	m_nodes[proxyID].object = object;
+	m_nodes[proxyID].height = 0;
+
+	InsertLeaf(proxyID);
+	return proxyID;
+}
+
+void DynamicTree::DestroyProxy(int proxyID)
+{
+	RemoveLeaf(proxyID);
+	FreeNode(proxyID);
+}
+
+bool DynamicTree::MoveProxy(int proxyID, const AABB& aabb, Vec2 displacement)
+{
+	const AABB fatAABB = Fatten(aabb, displacement);
+	const AABB& treeAABB = m_nodes[proxyID].aabb;
+
+	if (treeAABB.Contains(aabb)) {
+
+		// NOTE: If an object was moving quickly and then stopped, its fattened bounds can end up much bigger than they need
+		// to be. We let it through here so that it gets shrunk back down, otherwise it would keep generating useless pairs.
+		const AABB hugeAABB = { fatAABB.min - Vec2(4.0f * AABBMargin, 4.0f * AABBMargin), fatAABB.max + Vec2(4.0f * AABBMargin, 4.0f * AABBMargin) };
+		if (hugeAABB.Contains(treeAABB)) return false;
+	}
+
+	if (fatAABB.Overlaps(treeAABB)) {
+		// Small move, so refit the ancestors in place instead of paying for a full reinsertion.
+		m_nodes[proxyID].aabb = fatAABB;
+		Refit(m_nodes[proxyID].parent, false);
+	}
+	else {
+		// The object has jumped somewhere else entirely, so its old spot in the tree is no longer a good fit.
+		RemoveLeaf(proxyID);
+		m_nodes[proxyID].aabb = fatAABB;
+		InsertLeaf(proxyID);
+	}
+
+	return true;
+}
+
+void DynamicTree::Clear()
+{
+	m_nodes.clear();
+	m_root = NullNode;
+	m_freeList = NullNode;
+}
+
+int DynamicTree::AllocateNode()
+{
+	if (m_freeList == NullNode) {
+		m_nodes.emplace_back();
+		return static_cast<int>(m_nodes.size()) - 1;
+	}
+
+	const int nodeID = m_freeList;
+	m_freeList = m_nodes[nodeID].parent;
+	m_nodes[nodeID] = TreeNode();
+	return nodeID;
+}
+
+void DynamicTree::FreeNode(int nodeID)
+{
+	m_nodes[nodeID] = TreeNode();
+	m_nodes[nodeID].parent = m_freeList;
+	m_freeList = nodeID;
+}
+
+void DynamicTree::InsertLeaf(int leaf)
+{
+	if (m_root == NullNode) {
+		m_root = leaf;
+		m_nodes[leaf].parent = NullNode;
+		return;
+	}
+
+	// Walk down the tree, picking whichever child gives the smallest increase in perimeter (the surface area heuristic).
+	const AABB leafAABB = m_nodes[leaf].aabb;
+	int index = m_root;
+
+	while (!m_nodes[index].IsLeaf()) {
+		const TreeNode& node = m_nodes[index];
+
+		const float perimeter = node.aabb.GetPerimeter();
+		const float combinedPerimeter = AABB::Combine(node.aabb, leafAABB).GetPerimeter();
+
+		// Cost of creating a new parent for this node and the new leaf.
+		const float cost = 2.0f * combinedPerimeter;
+
+		// Minimum cost of pushing the leaf further down the tree.
+		const float inheritanceCost = 2.0f * (combinedPerimeter - perimeter);
+
+		auto descendCost = [&](int childID) {
+			const TreeNode& child = m_nodes[childID];
+			const float newPerimeter = AABB::Combine(leafAABB, child.aabb).GetPerimeter();
+			return child.IsLeaf() ? newPerimeter + inheritanceCost : (newPerimeter - child.aabb.GetPerimeter()) + inheritanceCost;
+		};
+
+		const float cost1 = descendCost(node.child1);
+		const float cost2 = descendCost(node.child2);
+
+		if (cost < cost1 && cost < cost2) break;
+
+		index = (cost1 < cost2) ? node.child1 : node.child2;
+	}
+
+	const int sibling = index;
+	const int oldParent = m_nodes[sibling].parent;
+
+	// NOTE: AllocateNode can grow m_nodes, so don't hold any references across this call.
+	const int newParent = AllocateNode();
+	m_nodes[newParent].parent = oldParent;
+	m_nodes[newParent].aabb = AABB::Combine(leafAABB, m_nodes[sibling].aabb);
+	m_nodes[newParent].height = m_nodes[sibling].height + 1;
+	m_nodes[newParent].child1 = sibling;
+	m_nodes[newParent].child2 = leaf;
+	m_nodes[sibling].parent = newParent;
+	m_nodes[leaf].parent = newParent;
+
+	if (oldParent != NullNode) {
+		if (m_nodes[oldParent].child1 == sibling) m_nodes[oldParent].child1 = newParent;
+		else m_nodes[oldParent].child2 = newParent;
+	}
+	else {
+		m_root = newParent;
+	}
+
+	Refit(newParent, true);
+}
+
+void DynamicTree::RemoveLeaf(int leaf)
+{
+	if (leaf == m_root) {
+		m_root = NullNode;
+		return;
+	}
+
+	const int parent = m_nodes[leaf].parent;
+	const int grandParent = m_nodes[parent].parent;
+	const int sibling = (m_nodes[parent].child1 == leaf) ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+	// The parent only existed to join the leaf and its sibling, so the sibling takes its place.
+	if (grandParent != NullNode) {
+		if (m_nodes[grandParent].child1 == parent) m_nodes[grandParent].child1 = sibling;
+		else m_nodes[grandParent].child2 = sibling;
+
+		m_nodes[sibling].parent = grandParent;
+		FreeNode(parent);
+		Refit(grandParent, true);
+	}
+	else {
+		m_root = sibling;
+		m_nodes[sibling].parent = NullNode;
+		FreeNode(parent);
+	}
+
+	m_nodes[leaf].parent = NullNode;
+}
+
+void DynamicTree::Refit(int nodeID, bool balance)
+{
+	while (nodeID != NullNode) {
+		if (balance) nodeID = Balance(nodeID);
+
+		TreeNode& node = m_nodes[nodeID];
+		const TreeNode& child1 = m_nodes[node.child1];
+		const TreeNode& child2 = m_nodes[node.child2];
+
+		node.height = 1 + Max(child1.height, child2.height);
+		node.aabb = AABB::Combine(child1.aabb, child2.aabb);
+
+		nodeID = node.parent;
+	}
+}
+
+// Performs a left or right rotation if the subtree rooted at A is imbalanced, and returns the index of the new subtree root.
+// A has children B and C, B has children D and E, and C has children F and G. If C is the taller child it gets rotated up
+// into A's place (and the same the other way round for B).
+int DynamicTree::Balance(int iA)
+{
+	TreeNode& A = m_nodes[iA];
+	if (A.IsLeaf() || A.height < 2) return iA;
+
+	const int iB = A.child1;
+	const int iC = A.child2;
+	TreeNode& B = m_nodes[iB];
+	TreeNode& C = m_nodes[iC];
+
+	const int balance = C.height - B.height;
+
+	// Rotate C up
+	if (balance > 1) {
+		const int iF = C.child1;
+		const int iG = C.child2;
+		TreeNode& F = m_nodes[iF];
+		TreeNode& G = m_nodes[iG];
+
+		C.child1 = iA;
+		C.parent = A.parent;
+		A.parent = iC;
+
+		if (C.parent != NullNode) {
+			if (m_nodes[C.parent].child1 == iA) m_nodes[C.parent].child1 = iC;
+			else m_nodes[C.parent].child2 = iC;
+		}
+		else {
+			m_root = iC;
+		}
+
+		if (F.height > G.height) {
+			C.child2 = iF;
+			A.child2 = iG;
+			G.parent = iA;
+			A.aabb = AABB::Combine(B.aabb, G.aabb);
+			C.aabb = AABB::Combine(A.aabb, F.aabb);
+			A.height = 1 + Max(B.height, G.height);
+			C.height = 1 + Max(A.height, F.height);
+		}
+		else {
+			C.child2 = iG;
+			A.child2 = iF;
+			F.parent = iA;
+			A.aabb = AABB::Combine(B.aabb, F.aabb);
+			C.aabb = AABB::Combine(A.aabb, G.aabb);
+			A.height = 1 + Max(B.height, F.height);
+			C.height = 1 + Max(A.height, G.height);
+		}
+
+		return iC;
+	}
+
+	// Rotate B up
+	if (balance < -1) {
+		const int iD = B.child1;
+		const int iE = B.child2;
+		TreeNode& D = m_nodes[iD];
+		TreeNode& E = m_nodes[iE];
+
+		B.child1 = iA;
+		B.parent = A.parent;
+		A.parent = iB;
+
+		if (B.parent != NullNode) {
+			if (m_nodes[B.parent].child1 == iA) m_nodes[B.parent].child1 = iB;
+			else m_nodes[B.parent].child2 = iB;
+		}
+		else {
+			m_root = iB;
+		}
+
+		if (D.height > E.height) {
+			B.child2 = iD;
+			A.child1 = iE;
+			E.parent = iA;
+			A.aabb = AABB::Combine(C.aabb, E.aabb);
+			B.aabb = AABB::Combine(A.aabb, D.aabb);
+			A.height = 1 + Max(C.height, E.height);
+			B.height = 1 + Max(A.height, D.height);
+		}
+		else {
+			B.child2 = iE;
+			A.child1 = iD;
+			D.parent = iA;
+			A.aabb = AABB::Combine(C.aabb, D.aabb);
+			B.aabb = AABB::Combine(A.aabb, E.aabb);
+			A.height = 1 + Max(C.height, D.height);
+			B.height = 1 + Max(A.height, E.height);
+		}
+
+		return iB;
+	}
+
+	return iA;
+}
+
+AABB DynamicTree::Fatten(const AABB& aabb, Vec2 displacement)
+{
+	AABB fatAABB = { aabb.min - Vec2(AABBMargin, AABBMargin), aabb.max + Vec2(AABBMargin, AABBMargin) };
+
+	// Stretch the bounds in the direction of motion so we don't need to update again next step.
+	const Vec2 d = DisplacementMultiplier * displacement;
+	if (d.x < 0.0f) fatAABB.min.x += d.x; else fatAABB.max.x += d.x;
+	if (d.y < 0.0f) fatAABB.min.y += d.y; else fatAABB.max.y += d.y;
+
+	return fatAABB;
+}
@@ -0,0 +1,91 @@
+#pragma once
+#include "AABB.h"
+#include <vector>
+
+class PhysicsObject;
+
+constexpr int NullNode = -1;
+
+struct TreeNode {
+
+	// Fattened bounds for leaves, and the union of both children for internal nodes.
+	AABB aabb;
+	PhysicsObject* object = nullptr;
+
+	// NOTE: Doubles as the "next" pointer while the node is sitting on the free list.
+	int parent = NullNode;
+	int child1 = NullNode;
+	int child2 = NullNode;
+
+	// Leaves have a height of 0, free nodes have a height of -1.
+	int height = -1;
+
+	[[nodiscard]] bool IsLeaf() const { return child1 == NullNode; }
+};
+
+// A dynamic bounding volume hierarchy. Every leaf holds a fattened AABB for one object, so objects can move around a little
+// without the tree needing to change. The tree is kept balanced with AVL-style rotations as leaves are inserted.
+class DynamicTree {
+public:
+	DynamicTree();
+
+	int CreateProxy(const AABB& aabb, PhysicsObject* object);
+	void DestroyProxy(int proxyID);
+
+	// Returns true if the fattened bounds had to change, meaning the proxy may have new overlaps.
+	bool MoveProxy(int proxyID, const AABB& aabb, Vec2 displacement);
+
+	void Clear();
+
+	[[nodiscard]] const AABB& GetFatAABB(int proxyID) const { return m_nodes[proxyID].aabb; }
+	[[nodiscard]] PhysicsObject* GetObject(int proxyID) const { return m_nodes[proxyID].object; }
+	[[nodiscard]] int GetHeight() const { return m_root == NullNode ? 0 : m_nodes[m_root].height; }
+
+	// Calls callback(proxyID) for every leaf that overlaps the given AABB. Return false from the callback to stop early.
+	template <typename Callback>
+	void Query(const AABB& aabb, Callback&& callback) const;
+
+private:
+	int AllocateNode();
+	void FreeNode(int nodeID);
+
+	void InsertLeaf(int leaf);
+	void RemoveLeaf(int leaf);
+
+	// Walks from the given node to the root, recomputing bounds and heights (and rotating if balance is true).
+	void Refit(int nodeID, bool balance);
+	int Balance(int nodeID);
+
+	static AABB Fatten(const AABB& aabb, Vec2 displacement);
+
+	std::vector<TreeNode> m_nodes;
+	int m_root = NullNode;
+	int m_freeList = NullNode;
+
+	mutable std::vector<int> m_queryStack;
+};
+
+template <typename Callback>
+void DynamicTree::Query(const AABB& aabb, Callback&& callback) const
+{
+	if (m_root == NullNode) return;
+
+	m_queryStack.clear();
+	m_queryStack.push_back(m_root);
+
+	while (!m_queryStack.empty()) {
+		const int nodeID = m_queryStack.back();
+		m_queryStack.pop_back();
+
+		const TreeNode& node = m_nodes[nodeID];
+		if (!node.aabb.Overlaps(aabb)) continue;
+
+		if (node.IsLeaf()) {
+			if (!callback(nodeID)) return;
+		}
+		else {
+			m_queryStack.push_back(node.child1);
+			m_queryStack.push_back(node.child2);
+		}
+	}
+}
@@ -1,4 +1,7 @@
+#include "ImGuiStuff.hpp"
 #include "imgui.h"
+#include <cstdint>
+#include <string>
 
 void SetupImGUITheme() {
 	ImGuiStyle& style = ImGui::GetStyle();
@@ -85,4 +88,34 @@ void SetupImGUITheme() {
 	style.Colors[ImGuiCol_NavWindowingHighlight] = ImVec4(1.0f, 1.0f, 1.0f, 0.7f);
 	style.Colors[ImGuiCol_NavWindowingDimBg] = ImVec4(0.8f, 0.8f, 0.8f, 0.2f);
 	style.Colors[ImGuiCol_ModalWindowDimBg] = ImVec4(0.8f, 0.8f, 0.8f, 0.35f);
-}
\ No newline at end of file
+}
+static std::string ImGUIDHelper(const char* name, const void* instance) {
+	return "##" + std::string(name) + "_" + std::to_string(reinterpret_cast<uintptr_t>(instance));
+}
+
+bool ImGuiPropertyDrawer::Draw(const char* name, Vec2& value, const void* instance) {
+	ImGui::TableNextRow();
+	ImGui::TableNextColumn(); ImGui::Text(name);
+	ImGui::TableNextColumn(); return ImGui::InputFloat2(ImGUIDHelper(name, instance).c_str(), &value.x);
+}
+
+bool ImGuiPropertyDrawer::Draw(const char* name, float& value, const void* instance) {
+	ImGui::TableNextRow();
+	ImGui::TableNextColumn(); ImGui::Text(name);
+	ImGui::TableNextColumn(); const bool changed = ImGui::InputFloat(ImGUIDHelper(name, instance).c_str(), &value);
+	if (value < 0.01f) value = 0.01f;
+	return changed;
+}
+
+bool ImGuiPropertyDrawer::Draw(const char* name, bool& value, const void* instance) {
+	ImGui::TableNextRow();
+	ImGui::TableNextColumn(); ImGui::Text(name);
+	ImGui::TableNextColumn(); return ImGui::Checkbox(ImGUIDHelper(name, instance).c_str(), &value);
+}
+
+bool ImGuiPropertyDrawer::Draw(const char* name, const char* value, const void* instance) {
+	ImGui::TableNextRow();
+	ImGui::TableNextColumn(); ImGui::Text(name);
+	ImGui::TableNextColumn(); ImGui::Text(value);
+	return false;
+}
@@ -1,3 +1,13 @@
 #pragma once
+#include "Reflection.h"
 
 void SetupImGUITheme();
+
+// Shows reflected properties as rows of the current ImGui table.
+class ImGuiPropertyDrawer : public PropertyDrawer {
+public:
+	bool Draw(const char* name, Vec2& value, const void* instance) override;
+	bool Draw(const char* name, float& value, const void* instance) override;
+	bool Draw(const char* name, bool& value, const void* instance) override;
+	bool Draw(const char* name, const char* value, const void* instance) override;
+};
@@ -0,0 +1,113 @@
+#include "Integrator.h"
+#include "Maths.h"
+#include "Profiler.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+SimdLevel Integrator::level = SimdLevel::SCALAR;
+bool Integrator::levelChosen = false;
+
+void Integrator::IntegrateForces(BodyStore& bodies, Vec2 gravity, float timeStep)
+{
+	PROFILE_ZONE("Integrator::IntegrateForces");
+
+	switch (GetLevel()) {
+	case SimdLevel::AVX2:
+		IntegrateForcesAVX2(bodies, gravity, timeStep, 0, bodies.GetAwakeCount());
+		break;
+	case SimdLevel::SSE2:
+		IntegrateForcesSSE2(bodies, gravity, timeStep, 0, bodies.GetAwakeCount());
+		break;
+	default:
+		IntegrateForcesScalar(bodies, gravity, timeStep, 0, bodies.GetAwakeCount());
+		break;
+	}
+}
+
+void Integrator::IntegrateVelocities(BodyStore& bodies, float timeStep)
+{
+	PROFILE_ZONE("Integrator::IntegrateVelocities");
+
+	switch (GetLevel()) {
+	case SimdLevel::AVX2:
+		IntegrateVelocitiesAVX2(bodies, timeStep, 0, bodies.GetAwakeCount());
+		break;
+	case SimdLevel::SSE2:
+		IntegrateVelocitiesSSE2(bodies, timeStep, 0, bodies.GetAwakeCount());
+		break;
+	default:
+		IntegrateVelocitiesScalar(bodies, timeStep, 0, bodies.GetAwakeCount());
+		break;
+	}
+}
+
+void IntegrateForcesScalar(BodyStore& bodies, Vec2 gravity, float timeStep, int begin, int end)
+{
+	for (int i = begin; i < end; i++) {
+		// NOTE: Static bodies have no inverse mass, and they shouldn't fall either.
+		const float gravityScale = bodies.invMass[i] > 0.0f ? 1.0f : 0.0f;
+
+		bodies.velocityX[i] += (gravity.x * gravityScale + bodies.forceX[i] * bodies.invMass[i]) * timeStep;
+		bodies.velocityY[i] += (gravity.y * gravityScale + bodies.forceY[i] * bodies.invMass[i]) * timeStep;
+
+		bodies.angularVelocity[i] += bodies.torque[i] * bodies.invMoment[i] * timeStep;
+		bodies.angularVelocity[i] *= AngularDamping;
+
+		bodies.forceX[i] = 0.0f;
+		bodies.forceY[i] = 0.0f;
+		bodies.torque[i] = 0.0f;
+	}
+}
+
+void IntegrateVelocitiesScalar(BodyStore& bodies, float timeStep, int begin, int end)
+{
+	for (int i = begin; i < end; i++) {
+		bodies.positionX[i] += bodies.velocityX[i] * timeStep;
+		bodies.positionY[i] += bodies.velocityY[i] * timeStep;
+		bodies.orientation[i] += bodies.angularVelocity[i] * timeStep;
+	}
+}
+
+SimdLevel Integrator::GetSupportedLevel()
+{
+#if defined(PHYSICS_HAS_AVX2) && (defined(__GNUC__) || defined(__clang__))
+	// NOTE: These also check that the OS saves the AVX registers.
+	if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return SimdLevel::AVX2;
+#elif defined(PHYSICS_HAS_AVX2) && defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 1);
+	const bool hasFMA = (info[2] & (1 << 12)) != 0;
+	const bool hasOSXSAVE = (info[2] & (1 << 27)) != 0;
+
+	__cpuidex(info, 7, 0);
+	const bool hasAVX2 = (info[1] & (1 << 5)) != 0;
+
+	// The OS has to have enabled saving the XMM and YMM registers too.
+	if (hasFMA && hasOSXSAVE && hasAVX2 && (_xgetbv(0) & 0x6) == 0x6) return SimdLevel::AVX2;
+#endif
+
+#if defined(PHYSICS_HAS_SSE2)
+	// Every x86-64 CPU has SSE2.
+	return SimdLevel::SSE2;
+#else
+	return SimdLevel::SCALAR;
+#endif
+}
+
+SimdLevel Integrator::GetLevel()
+{
+	if (!levelChosen) {
+		level = GetSupportedLevel();
+		levelChosen = true;
+	}
+	return level;
+}
+
+void Integrator::SetLevel(SimdLevel newLevel)
+{
+	level = static_cast<SimdLevel>(Min(static_cast<int>(newLevel), static_cast<int>(GetSupportedLevel())));
+	levelChosen = true;
+}
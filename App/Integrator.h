@@ -0,0 +1,47 @@
+#pragma once
+#include "BodyStore.h"
+
+// Crude angular damping, so spinning bodies eventually settle down.
+constexpr float AngularDamping = 0.99f;
+
+enum class SimdLevel : int {
+	SCALAR = 0,
+	SSE2 = 1,
+	AVX2 = 2,
+};
+
+// Integrates every awake body in the BodyStore, 4 (SSE2) or 8 (AVX2) at a time. The widest instruction set the CPU supports is picked
+// the first time it's used, falling back to plain scalar code.
+//
+// NOTE: The vector paths do exactly the same operations in the same order as the scalar path, so with PHYSICS_STRICT_DETERMINISM
+// defined (which also turns off FMA contraction) they all give bit-identical results. Without it, the AVX2 path uses FMA and can
+// differ in the last bit or so.
+class Integrator {
+public:
+	static void IntegrateForces(BodyStore& bodies, Vec2 gravity, float timeStep);
+	static void IntegrateVelocities(BodyStore& bodies, float timeStep);
+
+	[[nodiscard]] static SimdLevel GetSupportedLevel();
+	[[nodiscard]] static SimdLevel GetLevel();
+
+	// Mostly for comparing the paths against each other. Anything the CPU can't run is clamped to the supported level.
+	static void SetLevel(SimdLevel level);
+
+private:
+	static SimdLevel level;
+	static bool levelChosen;
+};
+
+// The kernels for each instruction set live in their own files, since they need different compiler flags. Each one integrates the
+// bodies in [begin, end).
+void IntegrateForcesSSE2(BodyStore& bodies, Vec2 gravity, float timeStep, int begin, int end);
+void IntegrateForcesAVX2(BodyStore& bodies, Vec2 gravity, float timeStep, int begin, int end);
+void IntegrateVelocitiesSSE2(BodyStore& bodies, float timeStep, int begin, int end);
+void IntegrateVelocitiesAVX2(BodyStore& bodies, float timeStep, int begin, int end);
+
+// Scalar versions. The vector kernels use these for their leftover bodies too.
+//
+// NOTE: These live in Integrator.cpp rather than inline here, otherwise IntegratorAVX2.cpp (built with AVX2 and FMA enabled) would
+// emit its own copy and the linker could pick that one for the fallback paths, which would then crash on CPUs without AVX2.
+void IntegrateForcesScalar(BodyStore& bodies, Vec2 gravity, float timeStep, int begin, int end);
+void IntegrateVelocitiesScalar(BodyStore& bodies, float timeStep, int begin, int end);
@@ -0,0 +1,84 @@
+#include "Integrator.h"
+
+#if defined(PHYSICS_HAS_AVX2)
+#include <immintrin.h>
+
+// a * b + c. Fused (one rounding instead of two) unless we need to match the scalar path exactly.
+static __m256 MultiplyAdd(__m256 a, __m256 b, __m256 c)
+{
+#if defined(PHYSICS_STRICT_DETERMINISM)
+	return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#else
+	return _mm256_fmadd_ps(a, b, c);
+#endif
+}
+
+void IntegrateForcesAVX2(BodyStore& bodies, Vec2 gravity, float timeStep, int begin, int end)
+{
+	const __m256 gravityX = _mm256_set1_ps(gravity.x);
+	const __m256 gravityY = _mm256_set1_ps(gravity.y);
+	const __m256 dt = _mm256_set1_ps(timeStep);
+	const __m256 damping = _mm256_set1_ps(AngularDamping);
+	const __m256 zero = _mm256_setzero_ps();
+	const __m256 one = _mm256_set1_ps(1.0f);
+
+	int i = begin;
+	for (; i + 8 <= end; i += 8) {
+		const __m256 invMass = _mm256_loadu_ps(&bodies.invMass[i]);
+		const __m256 invMoment = _mm256_loadu_ps(&bodies.invMoment[i]);
+
+		// NOTE: Multiplying by 1 or 0 (rather than masking the gravity out) keeps the signed zeros the same as the scalar path.
+		const __m256 gravityScale = _mm256_and_ps(_mm256_cmp_ps(invMass, zero, _CMP_GT_OQ), one);
+
+		const __m256 accelX = MultiplyAdd(_mm256_loadu_ps(&bodies.forceX[i]), invMass, _mm256_mul_ps(gravityX, gravityScale));
+		const __m256 accelY = MultiplyAdd(_mm256_loadu_ps(&bodies.forceY[i]), invMass, _mm256_mul_ps(gravityY, gravityScale));
+		const __m256 velocityX = MultiplyAdd(accelX, dt, _mm256_loadu_ps(&bodies.velocityX[i]));
+		const __m256 velocityY = MultiplyAdd(accelY, dt, _mm256_loadu_ps(&bodies.velocityY[i]));
+
+		const __m256 angularAccel = _mm256_mul_ps(_mm256_loadu_ps(&bodies.torque[i]), invMoment);
+		const __m256 angularVelocity = _mm256_mul_ps(MultiplyAdd(angularAccel, dt, _mm256_loadu_ps(&bodies.angularVelocity[i])), damping);
+
+		_mm256_storeu_ps(&bodies.velocityX[i], velocityX);
+		_mm256_storeu_ps(&bodies.velocityY[i], velocityY);
+		_mm256_storeu_ps(&bodies.angularVelocity[i], angularVelocity);
+
+		_mm256_storeu_ps(&bodies.forceX[i], zero);
+		_mm256_storeu_ps(&bodies.forceY[i], zero);
+		_mm256_storeu_ps(&bodies.torque[i], zero);
+	}
+
+	IntegrateForcesScalar(bodies, gravity, timeStep, i, end);
+}
+
+void IntegrateVelocitiesAVX2(BodyStore& bodies, float timeStep, int begin, int end)
+{
+	const __m256 dt = _mm256_set1_ps(timeStep);
+
+	int i = begin;
+	for (; i + 8 <= end; i += 8) {
+		const __m256 positionX = MultiplyAdd(_mm256_loadu_ps(&bodies.velocityX[i]), dt, _mm256_loadu_ps(&bodies.positionX[i]));
+		const __m256 positionY = MultiplyAdd(_mm256_loadu_ps(&bodies.velocityY[i]), dt, _mm256_loadu_ps(&bodies.positionY[i]));
+		const __m256 orientation = MultiplyAdd(_mm256_loadu_ps(&bodies.angularVelocity[i]), dt, _mm256_loadu_ps(&bodies.orientation[i]));
+
+		_mm256_storeu_ps(&bodies.positionX[i], positionX);
+		_mm256_storeu_ps(&bodies.positionY[i], positionY);
+		_mm256_storeu_ps(&bodies.orientation[i], orientation);
+	}
+
+	IntegrateVelocitiesScalar(bodies, timeStep, i, end);
+}
+
+#else
+
+// NOTE: Not an x86 build, so Integrator never picks this path. These only exist so everything still links.
+void IntegrateForcesAVX2(BodyStore& bodies, Vec2 gravity, float timeStep, int begin, int end)
+{
+	IntegrateForcesScalar(bodies, gravity, timeStep, begin, end);
+}
+
+void IntegrateVelocitiesAVX2(BodyStore& bodies, float timeStep, int begin, int end)
+{
+	IntegrateVelocitiesScalar(bodies, timeStep, begin, end);
+}
+
+#endif
@@ -0,0 +1,79 @@
+#include "Integrator.h"
+
+#if defined(PHYSICS_HAS_SSE2)
+#include <emmintrin.h>
+
+void IntegrateForcesSSE2(BodyStore& bodies, Vec2 gravity, float timeStep, int begin, int end)
+{
+	const __m128 gravityX = _mm_set1_ps(gravity.x);
+	const __m128 gravityY = _mm_set1_ps(gravity.y);
+	const __m128 dt = _mm_set1_ps(timeStep);
+	const __m128 damping = _mm_set1_ps(AngularDamping);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+
+	int i = begin;
+	for (; i + 4 <= end; i += 4) {
+		const __m128 invMass = _mm_loadu_ps(&bodies.invMass[i]);
+		const __m128 invMoment = _mm_loadu_ps(&bodies.invMoment[i]);
+
+		// NOTE: Multiplying by 1 or 0 (rather than masking the gravity out) keeps the signed zeros the same as the scalar path.
+		const __m128 gravityScale = _mm_and_ps(_mm_cmpgt_ps(invMass, zero), one);
+
+		__m128 velocityX = _mm_loadu_ps(&bodies.velocityX[i]);
+		__m128 velocityY = _mm_loadu_ps(&bodies.velocityY[i]);
+		__m128 angularVelocity = _mm_loadu_ps(&bodies.angularVelocity[i]);
+
+		const __m128 accelX = _mm_add_ps(_mm_mul_ps(gravityX, gravityScale), _mm_mul_ps(_mm_loadu_ps(&bodies.forceX[i]), invMass));
+		const __m128 accelY = _mm_add_ps(_mm_mul_ps(gravityY, gravityScale), _mm_mul_ps(_mm_loadu_ps(&bodies.forceY[i]), invMass));
+		velocityX = _mm_add_ps(velocityX, _mm_mul_ps(accelX, dt));
+		velocityY = _mm_add_ps(velocityY, _mm_mul_ps(accelY, dt));
+
+		const __m128 angularAccel = _mm_mul_ps(_mm_loadu_ps(&bodies.torque[i]), invMoment);
+		angularVelocity = _mm_add_ps(angularVelocity, _mm_mul_ps(angularAccel, dt));
+		angularVelocity = _mm_mul_ps(angularVelocity, damping);
+
+		_mm_storeu_ps(&bodies.velocityX[i], velocityX);
+		_mm_storeu_ps(&bodies.velocityY[i], velocityY);
+		_mm_storeu_ps(&bodies.angularVelocity[i], angularVelocity);
+
+		_mm_storeu_ps(&bodies.forceX[i], zero);
+		_mm_storeu_ps(&bodies.forceY[i], zero);
+		_mm_storeu_ps(&bodies.torque[i], zero);
+	}
+
+	IntegrateForcesScalar(bodies, gravity, timeStep, i, end);
+}
+
+void IntegrateVelocitiesSSE2(BodyStore& bodies, float timeStep, int begin, int end)
+{
+	const __m128 dt = _mm_set1_ps(timeStep);
+
+	int i = begin;
+	for (; i + 4 <= end; i += 4) {
+		const __m128 positionX = _mm_add_ps(_mm_loadu_ps(&bodies.positionX[i]), _mm_mul_ps(_mm_loadu_ps(&bodies.velocityX[i]), dt));
+		const __m128 positionY = _mm_add_ps(_mm_loadu_ps(&bodies.positionY[i]), _mm_mul_ps(_mm_loadu_ps(&bodies.velocityY[i]), dt));
+		const __m128 orientation = _mm_add_ps(_mm_loadu_ps(&bodies.orientation[i]), _mm_mul_ps(_mm_loadu_ps(&bodies.angularVelocity[i]), dt));
+
+		_mm_storeu_ps(&bodies.positionX[i], positionX);
+		_mm_storeu_ps(&bodies.positionY[i], positionY);
+		_mm_storeu_ps(&bodies.orientation[i], orientation);
+	}
+
+	IntegrateVelocitiesScalar(bodies, timeStep, i, end);
+}
+
+#else
+
+// NOTE: Not an x86 build, so Integrator never picks this path. These only exist so everything still links.
+void IntegrateForcesSSE2(BodyStore& bodies, Vec2 gravity, float timeStep, int begin, int end)
+{
+	IntegrateForcesScalar(bodies, gravity, timeStep, begin, end);
+}
+
+void IntegrateVelocitiesSSE2(BodyStore& bodies, float timeStep, int begin, int end)
+{
+	IntegrateVelocitiesScalar(bodies, timeStep, begin, end);
+}
+
+#endif
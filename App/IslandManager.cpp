@@ -0,0 +1,180 @@
+#include "IslandManager.h"
+#include "ContactConstraint.h"
+#include "Maths.h"
+#include "Profiler.h"
+#include <cfloat>
+#include <numeric>
+
+void IslandManager::Build(const BodyStore& bodies, const std::vector<ContactConstraint>& contacts)
+{
+	PROFILE_ZONE("IslandManager::Build");
+
+	const int awakeCount = bodies.GetAwakeCount();
+
+	m_parent.resize(awakeCount);
+	std::iota(m_parent.begin(), m_parent.end(), 0);
+
+	for (const ContactConstraint& contact : contacts) {
+		// NOTE: Contacts with static bodies don't join islands, and every non-static body in a contact was woken up before the
+		// contacts were made, so only contacts between two awake bodies matter here.
+		if (bodies.IsAwake(contact.A) && bodies.IsAwake(contact.B)) {
+			Union(contact.A, contact.B);
+		}
+	}
+
+	// Give every island a number from 0, in the order their first body shows up.
+	m_rootToIsland.assign(awakeCount, -1);
+	m_islandOfBody.resize(awakeCount);
+	int islandCount = 0;
+	for (int i = 0; i < awakeCount; i++) {
+		const int root = FindRoot(i);
+		if (m_rootToIsland[root] == -1) m_rootToIsland[root] = islandCount++;
+		m_islandOfBody[i] = m_rootToIsland[root];
+	}
+
+	// Counting sort the contacts by island. This keeps them in their original order within each island, so solving an island on
+	// its own gives exactly the same result as solving everything in one go.
+	m_islandContactStart.assign(islandCount + 1, 0);
+	for (const ContactConstraint& contact : contacts) {
+		const int island = m_islandOfBody[bodies.IsAwake(contact.A) ? contact.A : contact.B];
+		m_islandContactStart[island + 1]++;
+	}
+
+	for (int i = 0; i < islandCount; i++) {
+		m_islandContactStart[i + 1] += m_islandContactStart[i];
+	}
+
+	// Use the parent array as the write cursor for each island, since it isn't needed any more.
+	m_parent.assign(m_islandContactStart.begin(), m_islandContactStart.end() - 1);
+	m_islandContacts.resize(contacts.size());
+	for (int i = 0; i < static_cast<int>(contacts.size()); i++) {
+		const int island = m_islandOfBody[bodies.IsAwake(contacts[i].A) ? contacts[i].A : contacts[i].B];
+		m_islandContacts[m_parent[island]++] = i;
+	}
+
+	m_awakeIslandCount = islandCount;
+}
+
+void IslandManager::UpdateSleep(BodyStore& bodies, float timeStep, bool allowSleep)
+{
+	PROFILE_ZONE("IslandManager::UpdateSleep");
+
+	// Anything past this woke up after Build(), and SetAwake() already reset its sleep time.
+	const int awakeCount = Min(bodies.GetAwakeCount(), static_cast<int>(m_islandOfBody.size()));
+	const int islandCount = GetIslandCount();
+
+	// An island can only sleep if every body in it can.
+	m_islandSleepTime.assign(islandCount, FLT_MAX);
+	for (int i = 0; i < awakeCount; i++) {
+		const float speedSquared = bodies.velocityX[i] * bodies.velocityX[i] + bodies.velocityY[i] * bodies.velocityY[i];
+		const float angularSpeed = abs(bodies.angularVelocity[i]);
+
+		if (speedSquared > LinearSleepTolerance * LinearSleepTolerance || angularSpeed > AngularSleepTolerance) {
+			bodies.sleepTime[i] = 0.0f;
+		}
+		else {
+			bodies.sleepTime[i] += timeStep;
+		}
+
+		const int island = m_islandOfBody[i];
+		m_islandSleepTime[island] = Min(m_islandSleepTime[island], bodies.sleepTime[i]);
+	}
+
+	if (!allowSleep) return;
+
+	// Gather the handles first, since putting bodies to sleep moves the others around.
+	m_rootToIsland.assign(islandCount, -1);
+	m_newIslands.clear();
+	for (int i = 0; i < awakeCount; i++) {
+		const int island = m_islandOfBody[i];
+		if (m_islandSleepTime[island] < TimeToSleep) continue;
+
+		if (m_rootToIsland[island] == -1) {
+			m_rootToIsland[island] = static_cast<int>(m_newIslands.size());
+			m_newIslands.emplace_back();
+		}
+		m_newIslands[m_rootToIsland[island]].push_back(bodies.GetHandle(i));
+	}
+
+	for (const std::vector<BodyHandle>& island : m_newIslands) {
+		PutToSleep(bodies, island);
+	}
+
+	m_awakeIslandCount = islandCount - static_cast<int>(m_newIslands.size());
+}
+
+void IslandManager::WakeBody(BodyStore& bodies, int index)
+{
+	if (bodies.IsAwake(index) || bodies.IsStatic(index)) return;
+
+	const BodyHandle handle = bodies.GetHandle(index);
+	const int island = handle < static_cast<int>(m_sleepingIslandOf.size()) ? m_sleepingIslandOf[handle] : -1;
+
+	if (island == -1) {
+		bodies.SetAwake(index, true);
+		return;
+	}
+
+	for (const BodyHandle member : m_sleepingIslands[island]) {
+		bodies.SetAwake(bodies.GetIndex(member), true);
+		m_sleepingIslandOf[member] = -1;
+	}
+
+	m_sleepingIslands[island].clear();
+	m_freeIslands.push_back(island);
+}
+
+void IslandManager::WakeAll(BodyStore& bodies)
+{
+	for (int i = bodies.GetAwakeCount(); i < bodies.GetCount(); i++) {
+		if (!bodies.IsStatic(i)) bodies.SetAwake(i, true);
+	}
+
+	Clear();
+}
+
+void IslandManager::Clear()
+{
+	m_sleepingIslands.clear();
+	m_freeIslands.clear();
+	m_sleepingIslandOf.clear();
+}
+
+int IslandManager::FindRoot(int body)
+{
+	while (m_parent[body] != body) {
+		// Path halving, so the trees stay flat.
+		m_parent[body] = m_parent[m_parent[body]];
+		body = m_parent[body];
+	}
+	return body;
+}
+
+void IslandManager::Union(int a, int b)
+{
+	const int rootA = FindRoot(a);
+	const int rootB = FindRoot(b);
+	if (rootA != rootB) m_parent[rootB] = rootA;
+}
+
+void IslandManager::PutToSleep(BodyStore& bodies, const std::vector<BodyHandle>& island)
+{
+	int slot;
+	if (!m_freeIslands.empty()) {
+		slot = m_freeIslands.back();
+		m_freeIslands.pop_back();
+	}
+	else {
+		slot = static_cast<int>(m_sleepingIslands.size());
+		m_sleepingIslands.emplace_back();
+	}
+
+	m_sleepingIslands[slot] = island;
+
+	for (const BodyHandle handle : island) {
+		if (handle >= static_cast<int>(m_sleepingIslandOf.size())) m_sleepingIslandOf.resize(handle + 1, -1);
+		m_sleepingIslandOf[handle] = slot;
+
+		bodies.SetAwake(bodies.GetIndex(handle), false);
+	}
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include "BodyStore.h"
+#include <span>
+#include <vector>
+
+struct ContactConstraint;
+
+// Bodies are only allowed to sleep once they've been this slow for this long.
+// NOTE: Boxes resting flat get a two point contact now, so they settle properly instead of rocking between their corners, and the
+// angular tolerance doesn't need to be generous any more.
+constexpr float LinearSleepTolerance = 0.05f;
+constexpr float AngularSleepTolerance = 0.05f;
+constexpr float TimeToSleep = 0.5f;
+
+// Splits the awake bodies into islands (groups of bodies connected through contacts), and puts whole islands to sleep once every
+// body in them has settled. Static bodies don't join islands together, otherwise everything touching the ground would be one island.
+// Since no two islands share a moving body, they can also be solved independently of each other.
+//
+// NOTE: A body can't go to sleep on its own, because anything resting on it would then be resting on something that never moves.
+// Waking any body in a sleeping island wakes the whole island for the same reason.
+class IslandManager {
+public:
+	// Call once the contacts for this step have been set up (and nothing is going to wake up any more).
+	void Build(const BodyStore& bodies, const std::vector<ContactConstraint>& contacts);
+
+	// Call after the velocities have been integrated. Uses the islands from Build().
+	// NOTE: The continuous collision sweep can wake bodies up after Build(). Waking only ever adds bodies to the end of the awake
+	// range, so anything past the bodies Build() saw is treated as just woken up: it isn't in an island and can't sleep this step.
+	void UpdateSleep(BodyStore& bodies, float timeStep, bool allowSleep);
+
+	// Wakes the whole island the body is sleeping in. Does nothing for awake or static bodies.
+	void WakeBody(BodyStore& bodies, int index);
+	void WakeAll(BodyStore& bodies);
+
+	void Clear();
+
+	[[nodiscard]] int GetIslandCount() const { return static_cast<int>(m_islandContactStart.size()) - 1; }
+	[[nodiscard]] int GetAwakeIslandCount() const { return m_awakeIslandCount; }
+	[[nodiscard]] int GetSleepingIslandCount() const { return static_cast<int>(m_sleepingIslands.size() - m_freeIslands.size()); }
+
+	// Indices into the contact list for every contact in the island.
+	[[nodiscard]] std::span<const int> GetIslandContacts(int island) const
+	{
+		return { m_islandContacts.data() + m_islandContactStart[island], m_islandContacts.data() + m_islandContactStart[island + 1] };
+	}
+
+private:
+	int FindRoot(int body);
+	void Union(int a, int b);
+
+	void PutToSleep(BodyStore& bodies, const std::vector<BodyHandle>& island);
+
+	// Union-find over the awake bodies, rebuilt every step.
+	std::vector<int> m_parent;
+
+	// Which island each awake body is in this step.
+	std::vector<int> m_islandOfBody;
+
+	// The contacts grouped by island. Island i's contacts are m_islandContacts[m_islandContactStart[i]] up to
+	// m_islandContacts[m_islandContactStart[i + 1]].
+	std::vector<int> m_islandContactStart;
+	std::vector<int> m_islandContacts;
+
+	std::vector<float> m_islandSleepTime;
+	int m_awakeIslandCount = 0;
+
+	// Every sleeping island, as body handles (since the indices change whenever a body wakes or sleeps). Slots of islands that have
+	// been woken up are reused.
+	std::vector<std::vector<BodyHandle>> m_sleepingIslands;
+	std::vector<int> m_freeIslands;
+
+	// Which sleeping island each body handle belongs to, or -1.
+	std::vector<int> m_sleepingIslandOf;
+
+	std::vector<int> m_rootToIsland;
+	std::vector<std::vector<BodyHandle>> m_newIslands;
+};
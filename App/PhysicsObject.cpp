@@ -1,3 +1,13 @@
 #include "PhysicsObject.h"
 
-LineRenderer* PhysicsObject::lines = nullptr;
+BodyStore* PhysicsObject::bodies = nullptr;
+
+PhysicsObject::PhysicsObject(const ShapeType shapeType, const Vec2 position, const Vec2 velocity, const float orientation, const float invMass, const float invMoment) : m_ShapeID(shapeType)
+{
+	m_body = bodies->CreateBody(position, velocity, orientation, invMass, invMoment);
+}
+
+PhysicsObject::~PhysicsObject()
+{
+	bodies->DestroyBody(m_body);
+}
@@ -1,6 +1,8 @@
 #pragma once
 #include "math.h"
-#include "LineRenderer.h"
+#include "Maths.h"
+#include "AABB.h"
+#include "BodyStore.h"
 
 enum class ShapeType : int {
 	PLANE = 0,
@@ -8,31 +10,52 @@ enum class ShapeType : int {
 	BOX = 2,
 };
 
+// NOTE: The simulation state (position, velocity, etc.) lives in the BodyStore, so a PhysicsObject is mostly just a handle to its
+// body plus whatever shape data it needs. The accessors below look the body up every time, so don't use them in hot loops.
 class PhysicsObject {
 protected:
-	PhysicsObject(const ShapeType shapeType) : m_ShapeID(shapeType) {}
+	PhysicsObject(const ShapeType shapeType, const Vec2 position, const Vec2 velocity, const float orientation, const float invMass, const float invMoment);
 public:
 
     // NOTE: Marked as virtual since we are deleting through this base type.
-    virtual ~PhysicsObject() = default;
+    virtual ~PhysicsObject();
+	PhysicsObject(const PhysicsObject& other) = delete;
+	PhysicsObject& operator=(const PhysicsObject& other) = delete;
 
-	//virtual void FixedUpdate(Vec2 gravity, float timeStep) = 0;
-	virtual void IntegrateForces(Vec2 gravity, float timeStep) = 0;
-	virtual void IntegrateVelocity(float timeStep) = 0;
 	virtual void ResetPosition() = 0;
-	virtual void Draw() = 0;
 	ShapeType m_ShapeID;
 
+    // For the broad phase
+    virtual AABB GetAABB() const = 0;
+    int m_proxyID = -1;
+
+    [[nodiscard]] BodyHandle GetBody() const { return m_body; }
+    [[nodiscard]] int GetBodyIndex() const { return bodies->GetIndex(m_body); }
+
     // For collision resolution
-    virtual float GetInverseMass() const = 0;
-    virtual Vec2 GetVelocity() const = 0;
-	virtual void ApplyImpulse(const Vec2 impulse, const Vec2 contactpoint) = 0;
-	virtual void ApplyImpulse(const Vec2 impulse) = 0;
-    virtual void SetPosition(const Vec2 position) = 0;
-    virtual void SetOrientation(const float orientation) = 0;
-	virtual Vec2 GetPosition() const = 0;
-    virtual float GetOrientation() const = 0;
-	virtual float GetAngularVelocity() const = 0;
-	virtual float GetInverseMoment() const = 0;
-	static LineRenderer* lines;
+    [[nodiscard]] float GetInverseMass() const { return bodies->invMass[GetBodyIndex()]; }
+    [[nodiscard]] float GetInverseMoment() const { return bodies->invMoment[GetBodyIndex()]; }
+    [[nodiscard]] Vec2 GetVelocity() const { return bodies->GetVelocity(GetBodyIndex()); }
+    [[nodiscard]] float GetAngularVelocity() const { return bodies->angularVelocity[GetBodyIndex()]; }
+	[[nodiscard]] Vec2 GetPosition() const { return bodies->GetPosition(GetBodyIndex()); }
+    [[nodiscard]] float GetOrientation() const { return bodies->orientation[GetBodyIndex()]; }
+    [[nodiscard]] Vec2 GetPreviousPosition() const { return bodies->GetPreviousPosition(GetBodyIndex()); }
+    [[nodiscard]] float GetPreviousOrientation() const { return bodies->previousOrientation[GetBodyIndex()]; }
+    void SetPosition(const Vec2 position) { bodies->SetPosition(GetBodyIndex(), position); }
+    void SetVelocity(const Vec2 velocity) { bodies->SetVelocity(GetBodyIndex(), velocity); }
+    void SetOrientation(const float orientation) { bodies->orientation[GetBodyIndex()] = orientation; }
+	void ApplyImpulse(const Vec2 impulse, const Vec2 contactpoint) { bodies->ApplyImpulse(GetBodyIndex(), impulse, contactpoint); }
+	void ApplyImpulse(const Vec2 impulse) { SetVelocity(GetVelocity() + impulse * GetInverseMass()); } //This is assumed to be through the centre of mass, so won't impart torque
+
+    // Speculative bodies get contacts made with anything they could reach this step, before they're actually touching, so they
+    // can't tunnel. It means more contacts for the solver, so it's meant for projectiles rather than everything.
+    [[nodiscard]] bool GetSpeculative() const { return m_speculative; }
+    void SetSpeculative(const bool speculative) { m_speculative = speculative; }
+
+	// NOTE: Set by the PhysicsWorld, so there can only be one world around at a time.
+	static BodyStore* bodies;
+
+protected:
+	BodyHandle m_body = NullBody;
+	bool m_speculative = false;
 };
@@ -8,6 +8,8 @@
 #include "PhysicsObject.h"
 #include "Circle.h"
 #include "Plane.h"
+#include "ShapeRenderer.h"
+#include "LineLayers.h"
 #include "Box.h"
 #include "CollisionInfo.h"
 #include <iostream>
@@ -17,20 +19,21 @@
 #include "ImGuiStuff.hpp"
 #include "Reflection.h"
 #include "ContactConstraint.h"
+#include "Integrator.h"
+#include "LineRenderer.h"
+#include "Profiler.h"
 
-PhysicsScene::PhysicsScene()
+PhysicsScene::PhysicsScene() : m_simulation(m_world, 1.0f / 120.0f)
 {
 	//Use the constructor to set up the application info, because the harness
 	//needs this information early so it can set the name of the window when
 	//it creates it.
 	appInfo.appName = "Example Program";
+
 }
 
 PhysicsScene::~PhysicsScene()
 {
-	for (const PhysicsObject* actor : m_actors) {
-		delete actor;
-	}
 }
 
 void PhysicsScene::Initialise()
@@ -45,96 +48,149 @@ void PhysicsScene::Initialise()
     Circle::RegisterClass();
     Box::RegisterClass();
 
-	PhysicsObject::lines = lines;
-	m_gravity = { 0, -9.81f };
 	AddActor(new Plane({ 0.0f, 1.0f }, 0.0f));
 
 	SetupImGUITheme();
+
+	if (m_useSimulationThread) m_simulation.Start();
+}
+
+void PhysicsScene::FixedUpdate(float delta)
+{
+	// NOTE: The simulation thread keeps its own time, so this is only for when it's turned off.
+	if (!m_simulation.IsRunning() && m_isPhysicsSimulating) {
+		m_world.Simulate(delta);
+	}
 }
 
 void PhysicsScene::Update(float delta)
 {
-	//Everything that your program does every frame should go here.
-	//This includes rendering done with the line renderer!
-
-	DrawSceneGraph();
-	DrawDebugOptions();
-	DrawObjectCreator();
-
-	if (m_isPhysicsSimulating) {
-		m_contactConstraints.clear();
-
-		for (int outer = 0; outer < m_actors.size(); outer++) {
-			PhysicsObject* A = m_actors[outer];
-			for (int inner = outer + 1; inner < m_actors.size(); inner++) {
-				PhysicsObject* B = m_actors[inner];
-
-				//NOTE: The index for the function pointer array is given by: (A->m_ShapeID * N) + B, where N is the number of shape types.
-				const int index = static_cast<int>(A->m_ShapeID) * 3 + static_cast<int>(B->m_ShapeID);
-				CollisionInfo info = CollisionFunctions[index](A, B);
-				if (info.isColliding) {
-
-					// Create contact constraints
-					ContactConstraint constraint;
-					constraint.Setup(info, delta);
-					constraint.elasticity = elasticity;
-					m_contactConstraints.push_back(constraint);
+	//Everything that your program does once a frame, apart from drawing, should go here.
+	//Line rendering goes in Render, which gets told how far between fixed steps the frame is.
+	PROFILE_ZONE("PhysicsScene::Update");
+
+	{
+		// The UI edits the world directly, so the simulation thread has to wait until it's done.
+		std::unique_lock<std::mutex> lock = m_simulation.LockWorld();
+		DrawSceneGraph();
+		DrawDebugOptions();
+		DrawObjectCreator();
+	}
+	m_profilerPanel.Draw();
+
+	// NOTE: Done out here, since stopping the thread while holding the lock would deadlock if it was waiting on it.
+	if (m_useSimulationThread && !m_simulation.IsRunning()) m_simulation.Start();
+	if (!m_useSimulationThread && m_simulation.IsRunning()) m_simulation.Stop();
+
+	m_simulation.SetStepping(m_isPhysicsSimulating);
+}
+
+void PhysicsScene::Render(float alpha)
+{
+	DrawPlanes();
+	DrawWorld(alpha);
+}
+
+void PhysicsScene::DrawPlanes()
+{
+	// NOTE: Only this thread adds or removes actors, so the version can be checked without locking.
+	if (m_world.GetActorsVersion() != m_planesLayerVersion) {
+		layers->MarkDirty("Planes");
+		m_planesLayerVersion = m_world.GetActorsVersion();
+	}
+	if (!layers->BeginRebuild("Planes")) return;
+
+	std::unique_lock<std::mutex> lock = m_simulation.LockWorld();
+	LineRenderer& planes = layers->Get("Planes");
+	for (const PhysicsObject* actor : m_world.GetActors()) {
+		if (actor->m_ShapeID != ShapeType::PLANE) continue;
+
+		const ActorSnapshot plane = ActorSnapshot::FromActor(actor);
+		const Vec2 PlaneCenter = plane.distance * plane.normal;
+
+		// Get line directions
+		const Vec2 dir1 = plane.normal.GetRotatedBy90();
+		const Vec2 dir2 = plane.normal.GetRotatedBy270();
+
+		planes.DrawLineSegment(PlaneCenter, PlaneCenter + 25 * dir1);
+		planes.DrawLineSegment(PlaneCenter, PlaneCenter + 25 * dir2);
+	}
+}
+
+void PhysicsScene::DrawWorld(float alpha)
+{
+	if (!m_simulation.IsRunning()) {
+		// NOTE: Rendering usually runs at a different rate to Update, so draw partway through the last step rather than where it
+		// ended up, otherwise everything stutters.
+		for (const PhysicsObject* actor : m_world.GetActors()) {
+			DrawActor(ActorSnapshot::FromActor(actor, m_isPhysicsSimulating ? alpha : 1.0f));
+		}
+
+		if (m_debugShowContactPoints && m_isPhysicsSimulating) {
+			for (const ContactConstraint& constraint : m_world.GetContacts()) {
+				for (int i = 0; i < constraint.pointCount; i++) {
+					frameShapes->DrawCircle(constraint.points[i].collisionPoint, 0.05f, Colour::RED);
 				}
 			}
 		}
-		
-		for (PhysicsObject* actor : m_actors) {
-			actor->IntegrateForces(m_gravity, delta);
-		}
+		return;
+	}
 
+	// The simulation thread keeps its own time, so it works out its own alpha.
+	m_simulation.UpdateSnapshots();
 
-		for (int i = 0; i < 10; i++) {
-			for (auto& constraint : m_contactConstraints) {
-				if (m_debugShowContactPoints) lines->DrawCircle(constraint.collisionPoint, 0.05f, Colour::RED);
-				constraint.SolveVelocity();
-				constraint.SolveFriction();
-			}
+	const WorldSnapshot& previous = m_simulation.GetPrevious();
+	const WorldSnapshot& current = m_simulation.GetCurrent();
+
+	// Actors only line up between the two snapshots if none were added or removed in between.
+	if (previous.actorsVersion == current.actorsVersion && previous.actors.size() == current.actors.size()) {
+		const float snapshotAlpha = m_simulation.GetAlpha();
+		for (size_t i = 0; i < current.actors.size(); i++) {
+			DrawActor(ActorSnapshot::Interpolate(previous.actors[i], current.actors[i], snapshotAlpha));
 		}
-	
-		for (PhysicsObject* actor : m_actors) {
-			actor->IntegrateVelocity(delta);
+	}
+	else {
+		for (const ActorSnapshot& actor : current.actors) {
+			DrawActor(actor);
 		}
+	}
 
-
-}
-
-	// TODO: Move this to rendering()? Only problem is that we would have to do temporal anti-aliasing.
-	for (PhysicsObject* actor : m_actors) {
-		actor->Draw();
+	if (m_debugShowContactPoints) {
+		for (const Vec2 point : current.contactPoints) {
+			frameShapes->DrawCircle(point, 0.05f, Colour::RED);
+		}
 	}
 }
 
-void PhysicsScene::AddActor(PhysicsObject* actor)
+void PhysicsScene::DrawActor(const ActorSnapshot& actor)
 {
-	m_actors.push_back(actor);
-}
+	switch (actor.shape) {
+	case ShapeType::BOX: {
+		frameShapes->DrawBox(actor.position, actor.orientation, actor.halfExtents, actor.colour);
+	}
+	break;
 
-void PhysicsScene::RemoveActor(PhysicsObject* actor)
-{
+	case ShapeType::CIRCLE: {
+		frameShapes->DrawCircle(actor.position, actor.radius, actor.colour);
+	}
+	break;
 
-    // NOTE: This could be simplified using smart pointers.
-    
-	auto it = std::remove_if(m_actors.begin(), m_actors.end(), [actor](PhysicsObject* a) {
-		if (a == actor) {
-			delete a;
-			return true;
-		}
-		return false;
-		});
+	case ShapeType::PLANE:
+		// NOTE: Planes never move, so they're drawn once into their own layer by DrawPlanes() instead.
+		break;
 
-	m_actors.erase(it, m_actors.end());
+	default:
+		break;
+	}
 }
 
 void PhysicsScene::OnLeftClick()
 {
+        std::unique_lock<std::mutex> lock = m_simulation.LockWorld();
+
         switch (creatorInfo.shapetype) {
-        case ShapeType::BOX:
-            AddActor(new Box(
+        case ShapeType::BOX: {
+            Box* box = new Box(
                 cursorPos,
                 creatorInfo.velocity,
                 creatorInfo.mass,
@@ -142,18 +198,24 @@ void PhysicsScene::OnLeftClick()
                 creatorInfo.halfheight,
                 creatorInfo.orientation,
                 creatorInfo.colour
-            ));
+            );
+            box->SetSpeculative(creatorInfo.speculative);
+            AddActor(box);
+        }
             break;
 
-        case ShapeType::CIRCLE:
-            AddActor(new Circle(
+        case ShapeType::CIRCLE: {
+            Circle* circle = new Circle(
                 cursorPos,
                 creatorInfo.velocity,
                 creatorInfo.mass,
                 creatorInfo.radius,
                 creatorInfo.orientation,
                 creatorInfo.colour
-            ));
+            );
+            circle->SetSpeculative(creatorInfo.speculative);
+            AddActor(circle);
+        }
             break;
 		case ShapeType::PLANE:
 			AddActor(new Plane(creatorInfo.normal, creatorInfo.distance));
@@ -165,376 +227,6 @@ void PhysicsScene::OnLeftClick()
 }
 
 
-void PhysicsScene::ClearAllActor()
-{
-
-    // NOTE: This could be much simpler if I were using smart pointers for the actors.
-	auto it = std::remove_if(m_actors.begin(), m_actors.end(), [](PhysicsObject* a) {
-		delete a;
-		return true;
-		});
-
-	m_actors.erase(it, m_actors.end());
-}
-
-
-// NOTE: These collision functions return the collision normal from B to A. This is unconvential, and I only realised this when I had finished making the first half of these functions. 
-// This shouldn't cause any ununsual behaviour (the collision resolution function is consisent with this normal direction), but it is something to be aware of. 
-
-CollisionInfo PhysicsScene::Sphere2Plane(PhysicsObject* A, PhysicsObject* B) {
-
-	// NOTE: For circle-plane collisions, the collision normal will be either -planeNormal or planeNormal. 
-
-	CollisionInfo info;
-	const Circle* CircleA = static_cast<Circle*>(A);
-	const Plane* PlaneB = static_cast<Plane*>(B);
-
-	if (abs(Dot(CircleA->GetPosition(), PlaneB->GetNormal()) - PlaneB->GetDistance()) <= CircleA->GetRadius()) {
-		info.isColliding = true;
-
-		const float distanceToPlane = Dot(CircleA->GetPosition(), PlaneB->GetNormal()) - PlaneB->GetDistance();
-		info.collisionNormal = (distanceToPlane > 0) ? PlaneB->GetNormal() : -1.0f * PlaneB->GetNormal();
-		info.penetrationDepth = CircleA->GetRadius() - abs(distanceToPlane);
-		info.collisionPoint = CircleA->GetPosition() + CircleA->GetRadius() * info.collisionNormal;
-		info.A = A;
-		info.B = B;
-	}
-	return info;
-
-}
-
-CollisionInfo PhysicsScene::Plane2Sphere(PhysicsObject* A, PhysicsObject* B) {
-
-	// NOTE: For circle-plane collisions, the collision normal will be either -planeNormal or planeNormal. 
-
-	CollisionInfo info;
-	const Plane* PlaneA = static_cast<Plane*>(A);
-	const Circle* CircleB = static_cast<Circle*>(B);
-
-	if (abs(Dot(CircleB->GetPosition(), PlaneA->GetNormal()) - PlaneA->GetDistance()) <= CircleB->GetRadius()) {
-		info.isColliding = true;
-
-		// Get normal direction
-		const float distanceToPlane = Dot(CircleB->GetPosition(), PlaneA->GetNormal()) - PlaneA->GetDistance();
-		info.collisionNormal = (distanceToPlane > 0) ? -1.0f * PlaneA->GetNormal() : PlaneA->GetNormal();
-		info.penetrationDepth = CircleB->GetRadius() - abs(distanceToPlane);
-		info.collisionPoint = CircleB->GetPosition() + CircleB->GetRadius() * info.collisionNormal;
-		info.A = A;
-		info.B = B;
-	}
-
-	return info;
-}
-
-
-CollisionInfo PhysicsScene::Sphere2Sphere(PhysicsObject* A, PhysicsObject* B) {
-
-	CollisionInfo info;
-
-	const Circle* CircleA = static_cast<Circle*>(A);
-	const Circle* CircleB = static_cast<Circle*>(B);
-
-	if ((CircleA->GetPosition() - CircleB->GetPosition()).GetMagnitudeSquared() < (CircleA->GetRadius() + CircleB->GetRadius()) * (CircleA->GetRadius() + CircleB->GetRadius())) {
-		info.isColliding = true;
-		info.collisionNormal = (CircleA->GetPosition() - CircleB->GetPosition()).Normalise();
-		info.penetrationDepth = (CircleA->GetRadius() + CircleB->GetRadius()) - (CircleA->GetPosition() - CircleB->GetPosition()).GetMagnitude();
-		info.collisionPoint = CircleB->GetPosition() + CircleB->GetRadius() * info.collisionNormal;
-		info.A = A;
-		info.B = B;
-
-
-	}
-
-	return info;
-}
-
-CollisionInfo PhysicsScene::Plane2Plane(PhysicsObject* A, PhysicsObject* B) {
-	return CollisionInfo();
-}
-
-CollisionInfo PhysicsScene::Box2Plane(PhysicsObject* A, PhysicsObject* B) {
-
-	CollisionInfo info;
-	Box* BoxA = static_cast<Box*>(A);
-	const Plane* PlaneB = static_cast<Plane*>(B);
-
-	BoxA->UpdateLocalAxes();
-
-	const float distance = Dot(BoxA->GetPosition(), PlaneB->GetNormal()) - PlaneB->GetDistance();
-	const float r = BoxA->GetHalfWidth() * abs(Dot(BoxA->GetLocalXAxis(), PlaneB->GetNormal())) + BoxA->GetHalfHeight() * abs(Dot(BoxA->GetLocalYAxis(), PlaneB->GetNormal()));
-
-	if (abs(distance) <= r) {
-		info.isColliding = true;
-		info.penetrationDepth = r - abs(distance);
-		info.collisionNormal = distance > 0 ? PlaneB->GetNormal() : -1.0f * PlaneB->GetNormal();
- 		info.A = A;
-		info.B = B;
-
-        // NOTE: Find the corner with the lowest signed distance to the plane and use it as the collision point. 
-        // This is not the most sophisticated method, as with edge-to-plane collisions we should ideally get a collision manifold and average the points.
-        // However, this is beyond the scope of this project.
-       
-		const Vec2 vertices[4] = { BoxA->GetPosition() + BoxA->GetLocalXAxis() * BoxA->GetHalfWidth() + BoxA->GetLocalYAxis() * BoxA->GetHalfHeight(),
-								   BoxA->GetPosition() + BoxA->GetLocalXAxis() * BoxA->GetHalfWidth() - BoxA->GetLocalYAxis() * BoxA->GetHalfHeight(),
-								   BoxA->GetPosition() - BoxA->GetLocalXAxis() * BoxA->GetHalfWidth() + BoxA->GetLocalYAxis() * BoxA->GetHalfHeight(),
-								   BoxA->GetPosition() - BoxA->GetLocalXAxis() * BoxA->GetHalfWidth() - BoxA->GetLocalYAxis() * BoxA->GetHalfHeight()
-		};
-
-		float lowest = FLT_MAX;
-		Vec2 bestVertex;
-
-		for (int i = 0; i < 4; i++) {
-			float currentDistance = Dot(vertices[i], PlaneB->GetNormal()) - PlaneB->GetDistance();
-			if (currentDistance < lowest) {
-
-				lowest = currentDistance;
-				bestVertex = vertices[i];
-			}
-			else {
-				continue;
-			}
-
-			info.collisionPoint = bestVertex;
-		}
-	};
-	return info;
-
-}
-
-CollisionInfo PhysicsScene::Plane2Box(PhysicsObject* A, PhysicsObject* B) {
-	CollisionInfo info;
-	Box* BoxB = static_cast<Box*>(B);
-	const Plane* PlaneA = static_cast<Plane*>(A);
-
-	BoxB->UpdateLocalAxes();
-
-	const float distance = Dot(BoxB->GetPosition(), PlaneA->GetNormal()) - PlaneA->GetDistance();
-	const float r = BoxB->GetHalfWidth() * abs(Dot(BoxB->GetLocalXAxis(), PlaneA->GetNormal())) + BoxB->GetHalfHeight() * abs(Dot(BoxB->GetLocalYAxis(), PlaneA->GetNormal()));
-
-	if (abs(distance) <= r) {
-		info.isColliding = true;
-		info.penetrationDepth = r - abs(distance);
-        info.collisionNormal = distance > 0 ? -1.0f * PlaneA->GetNormal() : PlaneA->GetNormal();
- 		info.A = A;
-		info.B = B;
-
-        // NOTE: Find the corner with the lowest signed distance to the plane and use it as the collision point. 
-        // This is not the most sophisticated method, as with edge-to-plane collisions we should ideally get a collision manifold and average the points.
-        // However, this is beyond the scope of this project.
-	
-		const Vec2 vertices[4] = { BoxB->GetPosition() + BoxB->GetLocalXAxis() * BoxB->GetHalfWidth() + BoxB->GetLocalYAxis() * BoxB->GetHalfHeight(),
-								   BoxB->GetPosition() + BoxB->GetLocalXAxis() * BoxB->GetHalfWidth() - BoxB->GetLocalYAxis() * BoxB->GetHalfHeight(),
-								   BoxB->GetPosition() - BoxB->GetLocalXAxis() * BoxB->GetHalfWidth() + BoxB->GetLocalYAxis() * BoxB->GetHalfHeight(),
-								   BoxB->GetPosition() - BoxB->GetLocalXAxis() * BoxB->GetHalfWidth() - BoxB->GetLocalYAxis() * BoxB->GetHalfHeight()
-		};
-
-		float lowest = FLT_MAX;
-		Vec2 bestVertex;
-
-		for (int i = 0; i < 4; i++) {
-			float currentDistance = Dot(vertices[i], PlaneA->GetNormal()) - PlaneA->GetDistance();
-			if (currentDistance < lowest) {
-				lowest = currentDistance;
-				bestVertex = vertices[i];
-			}
-			else {
-				continue;
-			}
-
-			info.collisionPoint = bestVertex;
-		}
-	}
-	return info;
-}
-
-CollisionInfo PhysicsScene::Box2Sphere(PhysicsObject* A, PhysicsObject* B) {
-	CollisionInfo info;
-	Box* BoxA = static_cast<Box*>(A);
-	const Circle* CircleB = static_cast<Circle*>(B);
-
-	BoxA->UpdateLocalAxes();
-
-	//NOTE: Here we transform the Circle so that it is in OBB's local axes with the OBB centered at the origin.
-	const Vec2 RelativePos = CircleB->GetPosition() - BoxA->GetPosition();
-
-	Vec2 CirclePos;
-
-	CirclePos.x = Dot(RelativePos, BoxA->GetLocalXAxis());
-	CirclePos.y = Dot(RelativePos, BoxA->GetLocalYAxis());
-
-	// Get position on box that is closet to circle.
-	const Vec2 closest = { Clamp<float>(CirclePos.x, -BoxA->GetHalfWidth(),BoxA->GetHalfWidth()),
-	Clamp<float>(CirclePos.y,-BoxA->GetHalfHeight(),BoxA->GetHalfHeight()) };
-
-	const float distance = (closest - CirclePos).GetMagnitude();
-
-	if (distance <= CircleB->GetRadius()) {
-		info.isColliding = true;
-		info.penetrationDepth = CircleB->GetRadius() - distance;
-		const Vec2 collisionNormalLocal = (closest - CirclePos).Normalise();
-		info.collisionNormal = (BoxA->GetLocalXAxis() * collisionNormalLocal.x) + (BoxA->GetLocalYAxis() * collisionNormalLocal.y);
-		info.collisionPoint = (CircleB->GetPosition() + CircleB->GetRadius() * info.collisionNormal);
- 		info.A = A;
-		info.B = B;
-	}
-	return info;
-}
-
-CollisionInfo PhysicsScene::Sphere2Box(PhysicsObject* A, PhysicsObject* B) {
-
-	CollisionInfo info;
-	Box* BoxB = static_cast<Box*>(B);
-	const Circle* CircleA = static_cast<Circle*>(A);
-
-	//NOTE: Here we transform the Circle so that it is in OBB's local axes with the OBB centered at the origin.
-	BoxB->UpdateLocalAxes();
-	const Vec2 RelativePos = CircleA->GetPosition() - BoxB->GetPosition();
-
-	Vec2 CirclePos;
-
-	CirclePos.x = Dot(RelativePos, BoxB->GetLocalXAxis());
-	CirclePos.y = Dot(RelativePos, BoxB->GetLocalYAxis());
-
-	// Get position on box that is closet to circle.
-	const Vec2 closest = { Clamp<float>(CirclePos.x, -BoxB->GetHalfWidth(),BoxB->GetHalfWidth()),
-	Clamp<float>(CirclePos.y,-BoxB->GetHalfHeight(),BoxB->GetHalfHeight()) };
-
-	const float distance = (closest - CirclePos).GetMagnitude();
-
-	if (distance <= CircleA->GetRadius()) {
-		info.isColliding = true;
-		info.penetrationDepth = CircleA->GetRadius() - distance;
-		const Vec2 collisionNormalLocal = (CirclePos - closest).Normalise();
-		info.collisionNormal = (BoxB->GetLocalXAxis() * collisionNormalLocal.x) + (BoxB->GetLocalYAxis() * collisionNormalLocal.y);
-		info.collisionPoint = (CircleA->GetPosition() - CircleA->GetRadius() * info.collisionNormal);
-		info.A = A;
-		info.B = B;
-
-	}
-	return info;
-}
-
-CollisionInfo PhysicsScene::Box2Box(PhysicsObject* A, PhysicsObject* B) {
-
-	CollisionInfo info;
-	Box* BoxA = static_cast<Box*>(A);
-	Box* BoxB = static_cast<Box*>(B);
-
-	// Update local axes
-	BoxA->UpdateLocalAxes();
-	BoxB->UpdateLocalAxes();
-
-	// SAT
-	Vec2 axes[4] = { BoxA->GetLocalXAxis(), BoxA->GetLocalYAxis(), BoxB->GetLocalXAxis(), BoxB->GetLocalYAxis() };
-	Vec2 bestAxis;
-	float minOverlap = FLT_MAX;
-	int bestIndex;
-
-	for (int index = 0; index < 4; index++) {
-
-		Vec2 axis = axes[index];
-		const float dist = Dot(BoxA->GetPosition() - BoxB->GetPosition(), axis);
-		const float rA = abs(Dot(BoxA->GetLocalXAxis() * BoxA->GetHalfWidth(), axis)) + abs(Dot(BoxA->GetLocalYAxis() * BoxA->GetHalfHeight(), axis));
-		const float rB = abs(Dot(BoxB->GetLocalXAxis() * BoxB->GetHalfWidth(), axis)) + abs(Dot(BoxB->GetLocalYAxis() * BoxB->GetHalfHeight(), axis));
-
-		const float overlap = (rA + rB) - abs(dist);
-
-		// Separating axis found
-		if (overlap <= 0) return info;
-
-		if (overlap < minOverlap) {
-			minOverlap = overlap;
-			bestAxis = (dist > 0) ? axis : -1.0f * axis;
-			bestIndex = index;
-		}
-	}
-
-	// NOTE: The idea here is to project all the vertices of the incident shape onto the separating axis. Then, take the one with the lowest value to
-	// be the collision point.
-    // Like with the Box2Plane collision, this is not the most sophisticated approach, as does not handle edge-to-edge collision nicely. Ideally we would get a collision manifold
-    // and average the points.
-
-	if (bestIndex == 1 || bestIndex == 2) {
-		// BoxA owns the best axis, so project BoxB vertices onto that.
-		float lowestProj = FLT_MAX;
-		Vec2 bestVertex;
-
-		Vec2 vertices[4] = {
-			BoxB->GetPosition() + BoxB->GetLocalXAxis() * BoxB->GetHalfWidth() + BoxB->GetLocalYAxis() * BoxB->GetHalfHeight(),
-			BoxB->GetPosition() + BoxB->GetLocalXAxis() * BoxB->GetHalfWidth() - BoxB->GetLocalYAxis() * BoxB->GetHalfHeight(),
-			BoxB->GetPosition() - BoxB->GetLocalXAxis() * BoxB->GetHalfWidth() + BoxB->GetLocalYAxis() * BoxB->GetHalfHeight(),
-			BoxB->GetPosition() - BoxB->GetLocalXAxis() * BoxB->GetHalfWidth() - BoxB->GetLocalYAxis() * BoxB->GetHalfHeight(),
-		};
-
-		for (int i = 0; i < 4; i++) {
-			float thisProj = Dot(vertices[i], -1.0f * bestAxis);
-			if (thisProj < lowestProj) {
-				lowestProj = thisProj;
-				bestVertex = vertices[i];
-			}
-		}
-		info.collisionPoint = bestVertex;
-	}
-
-	else {
-		float lowestProj = FLT_MAX;
-		Vec2 bestVertex;
-		// BoxB owns the best axis, so project BoxA vertices onto that.
-		Vec2 vertices[4] = {
-				BoxA->GetPosition() + BoxA->GetLocalXAxis() * BoxA->GetHalfWidth() + BoxA->GetLocalYAxis() * BoxA->GetHalfHeight(),
-				BoxA->GetPosition() + BoxA->GetLocalXAxis() * BoxA->GetHalfWidth() - BoxA->GetLocalYAxis() * BoxA->GetHalfHeight(),
-				BoxA->GetPosition() - BoxA->GetLocalXAxis() * BoxA->GetHalfWidth() + BoxA->GetLocalYAxis() * BoxA->GetHalfHeight(),
-				BoxA->GetPosition() - BoxA->GetLocalXAxis() * BoxA->GetHalfWidth() - BoxA->GetLocalYAxis() * BoxA->GetHalfHeight(),
-		};
-
-		for (int i = 0; i < 4; i++) {
-			float thisProj = Dot(vertices[i], bestAxis);
-			if (thisProj < lowestProj) {
-				lowestProj = thisProj;
-				bestVertex = vertices[i];
-			}
-		}
-		info.collisionPoint = bestVertex;
-	}
-	info.isColliding = true;
-	info.penetrationDepth = minOverlap;
-	info.collisionNormal = bestAxis;
-	info.A = A;
-	info.B = B;
-
-	return info;
-}
-
-
-//void PhysicsScene::ResolveCollisions(PhysicsObject* A, PhysicsObject* B, const CollisionInfo& info) {
-//
-//	float e = 0.5f;
-//	Vec2 rA = info.collisionPoint - A->GetPosition();
-//	Vec2 rB = info.collisionPoint - B->GetPosition();
-//
-//	float rACrossN = PseudoCross(rA, info.collisionNormal);
-//	float rBCrossN = PseudoCross(rB, info.collisionNormal);
-//
-//	Vec2 relativeVelocity = (A->GetVelocity() + PseudoCross(rA, A->GetAngularVelocity()))
-//		- (B->GetVelocity() + PseudoCross(rB, B->GetAngularVelocity()));
-//
-//	if (Dot(relativeVelocity, info.collisionNormal) < 0) {
-//		if (m_debugShowContactPoints) lines->DrawCircle(info.collisionPoint, 0.05f, Colour::RED);
-//		float impulseMagnitude = -(1 + elasticity) * (Dot(relativeVelocity, info.collisionNormal)) /
-//			(A->GetInverseMass() + B->GetInverseMass() + (rACrossN * rACrossN) * A->GetInverseMoment() + (rBCrossN * rBCrossN) * B->GetInverseMoment());
-//		A->ApplyImpulse(impulseMagnitude * info.collisionNormal, info.collisionPoint);
-//		B->ApplyImpulse(-1.0f * impulseMagnitude * info.collisionNormal, info.collisionPoint);
-//	}
-//
-//	const float totalInverseMass = A->GetInverseMass() + B->GetInverseMass();
-//	if (totalInverseMass > 0.0f) {
-//		const Vec2 correction = (info.penetrationDepth / totalInverseMass) * info.collisionNormal;
-//		A->SetPosition(A->GetPosition() + A->GetInverseMass() * correction);
-//		B->SetPosition(B->GetPosition() - B->GetInverseMass() * correction);
-//	}
-//
-//}
-
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
 void PhysicsScene::DisplayActor(PhysicsObject* Actor) {
@@ -573,23 +265,24 @@ void PhysicsScene::DisplayActor(PhysicsObject* Actor) {
 		}
 
 		if (isOpen) {
+			bool edited = false;
 			if (ImGui::BeginTable("Properties", 2, ImGuiTableFlags_SizingStretchProp)) {
                 switch(CastedActor->m_ShapeID){
                     case(ShapeType::CIRCLE):
                         for (auto& prop : GetType<RigidBody>().properties) {
-                            prop->Draw(CastedActor);
+                            edited |= prop->Draw(CastedActor, m_propertyDrawer);
                         }
                         for (auto& prop : GetType<Circle>().properties) {
-                                prop->Draw(static_cast<Circle*>(CastedActor));
+                                edited |= prop->Draw(static_cast<Circle*>(CastedActor), m_propertyDrawer);
                         }
                         break;
 
                     case(ShapeType::BOX):
                         for (auto& prop : GetType<RigidBody>().properties) {
-                            prop->Draw(CastedActor);
+                            edited |= prop->Draw(CastedActor, m_propertyDrawer);
                         }
                         for (auto& prop : GetType<Box>().properties) {
-                                prop->Draw(static_cast<Box*>(CastedActor));
+                                edited |= prop->Draw(static_cast<Box*>(CastedActor), m_propertyDrawer);
                         }
                         break;
 
@@ -602,6 +295,9 @@ void PhysicsScene::DisplayActor(PhysicsObject* Actor) {
 			CastedActor->RefreshInverseMass();
 			CastedActor->RefreshMoment();
 
+			// A sleeping body won't notice it's been moved (or that it's now floating) unless we wake it up.
+			if (edited) m_world.WakeActor(CastedActor);
+
 			ImGui::EndTable();
 			if (ImGui::Button("Delete Actor##")) {
 				// This ensures the selected actor is not a dangling pointer.
@@ -620,7 +316,7 @@ void PhysicsScene::DrawSceneGraph()
 {
 	ImGui::Begin("Scene Graph");
 	if (ImGui::TreeNode("Scene")) {
-		for (const auto actor : m_actors) {
+		for (const auto actor : m_world.GetActors()) {
 			DisplayActor(actor);
 		}
 		ImGui::TreePop();
@@ -661,7 +357,7 @@ void PhysicsScene::DrawDebugOptions()
 
 
 		if (ImGui::Button("Save Scene")) {
-			json savedata = serialiser.Save(m_actors);
+			json savedata = serialiser.Save(m_world.GetActors());
 			OpenSaveFileDialogue(savedata);
 		}
 
@@ -674,10 +370,111 @@ void PhysicsScene::DrawDebugOptions()
 		}
 
 		ImGui::TableNextRow();
-		ImGui::TableNextColumn(); ImGui::InputFloat2("Gravity", &m_gravity.x, "%.2f");
+		ImGui::TableNextColumn();
+		if (ImGui::InputFloat2("Gravity", &m_world.settings.gravity.x, "%.2f")) {
+			m_world.WakeAll();
+		}
+
+		ImGui::TableNextRow();
+		ImGui::TableNextColumn(); ImGui::InputFloat("Elasticity", &m_world.settings.elasticity, 0.0f, 0.0f, " % .2f");
+
+		ImGui::TableNextRow();
+		ImGui::TableNextColumn(); ImGui::SliderInt("Solver iterations", &m_world.settings.solverIterations, 1, 20);
+
+		ImGui::TableNextRow();
+		ImGui::TableNextColumn(); ImGui::Checkbox("Warm starting", &m_world.settings.warmStarting);
+
+		ImGui::TableNextRow();
+		ImGui::TableNextColumn();
+
+		ImGui::Checkbox("Auto-pick broad phase", &m_world.settings.autoSelectBroadPhase);
+
+		ImGui::TableNextRow();
+		ImGui::TableNextColumn();
+
+		const char* broadPhaseNames[] = { "Brute Force", "AABB Tree", "Sweep and Prune", "Spatial Hash Grid" };
+		int broadPhaseIndex = static_cast<int>(m_world.GetBroadPhaseType());
+		ImGui::BeginDisabled(m_world.settings.autoSelectBroadPhase);
+		if (ImGui::Combo("Broad Phase", &broadPhaseIndex, broadPhaseNames, IM_ARRAYSIZE(broadPhaseNames))) {
+			m_world.SetBroadPhase(static_cast<BroadPhaseType>(broadPhaseIndex));
+		}
+		ImGui::EndDisabled();
+
+		ImGui::TableNextRow();
+		ImGui::TableNextColumn();
+
+		if (ImGui::Checkbox("Allow sleeping", &m_world.settings.allowSleeping) && !m_world.settings.allowSleeping) {
+			m_world.WakeAll();
+		}
+
+		ImGui::TableNextRow();
+		ImGui::TableNextColumn(); ImGui::Text("Islands: %d awake, %d asleep", m_world.GetAwakeIslandCount(), m_world.GetSleepingIslandCount());
+
+		ImGui::TableNextRow();
+		ImGui::TableNextColumn();
+		ImGui::Checkbox("Simulation thread", &m_useSimulationThread);
+
+		// NOTE: Only the same-thread path goes through the harness's fixed updates, so only it can fall behind like this.
+		ImGui::TableNextRow();
+		ImGui::TableNextColumn(); ImGui::Text("Time dilation: %.0f%%", timeDilation * 100.0f);
+
+		ImGui::TableNextRow();
+		ImGui::TableNextColumn();
+		ImGui::Checkbox("Adaptive substeps", &m_world.settings.adaptiveSubstepping);
+		ImGui::BeginDisabled(!m_world.settings.adaptiveSubstepping);
+		ImGui::SliderInt("Max substeps", &m_world.settings.maxSubsteps, 1, 16);
+		ImGui::EndDisabled();
+
+		ImGui::TableNextRow();
+		ImGui::TableNextColumn(); ImGui::Text("Substeps last step: %d", m_world.GetLastSubstepCount());
+
+		ImGui::TableNextRow();
+		ImGui::TableNextColumn();
+		ImGui::Checkbox("Continuous collision", &m_world.settings.continuousCollision);
+
+		ImGui::TableNextRow();
+		ImGui::TableNextColumn();
+		ImGui::Checkbox("Speculative contacts", &m_world.settings.speculativeContacts);
+
+		ImGui::TableNextRow();
+		ImGui::TableNextColumn(); ImGui::Text("Swept last step: %d bodies, %d hits", m_world.GetLastSweptCount(), m_world.GetLastSweepHitCount());
 
 		ImGui::TableNextRow();
-		ImGui::TableNextColumn(); ImGui::InputFloat("Elasticity", &elasticity, 0.0f, 0.0f, " % .2f");
+		ImGui::TableNextColumn();
+		ImGui::Checkbox("Parallel solver", &m_world.settings.parallelSolve);
+
+		// NOTE: Only matters for islands big enough to get coloured.
+		bool solverSimd = m_world.GetSolver().GetSimd();
+		ImGui::BeginDisabled(Integrator::GetSupportedLevel() == SimdLevel::SCALAR);
+		if (ImGui::Checkbox("SIMD contact batches", &solverSimd)) m_world.GetSolver().SetSimd(solverSimd);
+		ImGui::EndDisabled();
+
+		ImGui::TableNextRow();
+		ImGui::TableNextColumn();
+		ImGui::Text("Solver: %d threads, %d large islands, %d colours", m_world.GetThreadCount(), m_world.GetSolver().GetLargeIslandCount(), m_world.GetSolver().GetColourCount());
+
+		ImGui::TableNextRow();
+		ImGui::TableNextColumn();
+
+		// NOTE: Only lists the paths this CPU can actually run.
+		const char* integratorNames[] = { "Scalar", "SSE2", "AVX2" };
+		int integratorIndex = static_cast<int>(Integrator::GetLevel());
+		if (ImGui::Combo("Integrator", &integratorIndex, integratorNames, static_cast<int>(Integrator::GetSupportedLevel()) + 1)) {
+			Integrator::SetLevel(static_cast<SimdLevel>(integratorIndex));
+		}
+
+		ImGui::TableNextRow();
+		ImGui::TableNextColumn();
+
+		// NOTE: Ends up next to the executable. Open it in chrome://tracing or ui.perfetto.dev.
+		if (!Profiler::IsCapturing()) {
+			if (ImGui::Button("Start Trace Capture") && !Profiler::StartCapture("trace.json")) {
+				std::cout << "Failed to open trace.json for writing.\n";
+			}
+		}
+		else if (ImGui::Button("Stop Trace Capture (trace.json)")) {
+			Profiler::StopCapture();
+		}
 
 		ImGui::EndTable();
 	}
@@ -708,13 +505,9 @@ void SDLCALL PhysicsScene::OnLoadFileSelected(void* userdata, const char* const*
 		std::istreambuf_iterator<char>()
 	);
 
-	//NOTE: Have to do this weird shit because this callback is asynchronous. 
-	char* data = new char[contents.length() + 1];
-	memcpy(data, contents.data(), contents.length());
-	data[contents.length()] = '\0';
-
 	PhysicsScene* ref = (PhysicsScene*)(userdata);
-	ref->serialiser.Load(ref, data);
+	std::unique_lock<std::mutex> lock = ref->m_simulation.LockWorld();
+	ref->serialiser.Load(&ref->m_world, contents.c_str());
 }
 
 void SDLCALL PhysicsScene::SaveFile(void* userdata, const char* const* filelist, int filter) {
@@ -817,6 +610,9 @@ void PhysicsScene::DrawObjectCreator()
 
 			ImGui::TableNextColumn(); ImGui::Text("Half Height");
 			ImGui::TableNextColumn(); ImGui::InputFloat("##6", &creatorInfo.halfheight);
+
+			ImGui::TableNextColumn(); ImGui::Text("Speculative");
+			ImGui::TableNextColumn(); ImGui::Checkbox("##7", &creatorInfo.speculative);
 			break;
 
 		case ShapeType::CIRCLE:
@@ -834,6 +630,9 @@ void PhysicsScene::DrawObjectCreator()
 
 			ImGui::TableNextColumn(); ImGui::Text("Orientation");
 			ImGui::TableNextColumn(); ImGui::InputFloat("##5", &creatorInfo.orientation);
+
+			ImGui::TableNextColumn(); ImGui::Text("Speculative");
+			ImGui::TableNextColumn(); ImGui::Checkbox("##6", &creatorInfo.speculative);
 			break;
 
 		case ShapeType::PLANE:
@@ -1,14 +1,15 @@
 #pragma once
 
 #include "Application.h"
-#include "PhysicsObject.h"
-#include <vector>
+#include "PhysicsWorld.h"
+#include "ImGuiStuff.hpp"
+#include "ProfilerPanel.h"
+#include "SimulationThread.h"
 #include "Serialiser.h"
+#include <SDL3/SDL_dialog.h>
 
 
 class PhysicsObject;
-struct CollisionInfo;
-struct ContactConstraint;
 
 // These are the default values for objects being created
 struct ObjectCreatorInfo {
@@ -18,6 +19,8 @@ struct ObjectCreatorInfo {
     float mass = 1.0f;
     float orientation = 0.0f;
     Colour colour = Colour::RED;
+    // For projectiles, see PhysicsObject::SetSpeculative().
+    bool speculative = false;
 
     // Specific to circle 
     float radius = 0.25f;
@@ -36,52 +39,42 @@ class PhysicsScene : public Application
 private:
 	//Any data that should persist for the duration of your program,
 	//declare it here.
-	Vec2 m_gravity;
 	float m_timestep;
-	std::vector<PhysicsObject*> m_actors;
+
+	PhysicsWorld m_world;
     bool m_debugShowContactPoints = false;
     bool m_isPhysicsSimulating = false;
-    Serialiser serialiser;
-    float elasticity = 0.3f;
 
-    std::vector<ContactConstraint> m_contactConstraints;
+    // NOTE: Declared after the world, so it gets stopped before the world is destroyed.
+    SimulationThread m_simulation;
+    bool m_useSimulationThread = true;
+    // What the actors version was when the planes layer was last drawn.
+    uint64_t m_planesLayerVersion = UINT64_MAX;
+    Serialiser serialiser;
+    ImGuiPropertyDrawer m_propertyDrawer;
+    ProfilerPanel m_profilerPanel;
 public:
 	PhysicsScene();
 	~PhysicsScene();
 	PhysicsScene(const PhysicsScene& other) = delete;
 	PhysicsScene& operator=(const PhysicsScene& other) = delete;
 	void Initialise() override;
+	void FixedUpdate(float delta) override;
 	void Update(float delta) override;
-	void AddActor(PhysicsObject* actor);
-	void RemoveActor(PhysicsObject* actor);
+	void Render(float alpha) override;
+	void AddActor(PhysicsObject* actor) { m_world.AddActor(actor); }
+	void RemoveActor(PhysicsObject* actor) { m_world.RemoveActor(actor); }
 	void OnLeftClick() override;
 	void SetGravity(const Vec2 gravity) {}
-    void ClearAllActor();
-	typedef CollisionInfo (*CollisionFunction)(PhysicsObject*, PhysicsObject*);
-    //index = (A->m_ShapeID * N) + B
-	CollisionFunction CollisionFunctions[9] = {Plane2Plane, Plane2Sphere, Plane2Box,
-                                               Sphere2Plane, Sphere2Sphere, Sphere2Box,
-                                                Box2Plane, Box2Sphere, Box2Box};
-
-    static CollisionInfo Sphere2Sphere(PhysicsObject* A, PhysicsObject* B);
-    static CollisionInfo Sphere2Plane(PhysicsObject* A, PhysicsObject* B);
-    static CollisionInfo Sphere2Box(PhysicsObject* A, PhysicsObject* B);
-
-    static CollisionInfo Plane2Sphere(PhysicsObject* A, PhysicsObject* B);
-    static CollisionInfo Plane2Plane(PhysicsObject* A, PhysicsObject* B);
-    static CollisionInfo Plane2Box(PhysicsObject* A, PhysicsObject* B);
-
-    static CollisionInfo Box2Plane(PhysicsObject* A, PhysicsObject* B);
-    static CollisionInfo Box2Sphere(PhysicsObject* A, PhysicsObject* B);
-    static CollisionInfo Box2Box(PhysicsObject* A, PhysicsObject* B);
+    void ClearAllActor() { m_world.ClearAllActors(); }
 
+    void DrawActor(const ActorSnapshot& actor);
+    void DrawWorld(float alpha);
+    void DrawPlanes();
     void DisplayActor(PhysicsObject* Actor);
     void DrawSceneGraph();
     void DrawDebugOptions();
 
-    // NOTE: Only supports linear collisions for now.
-    void ResolveCollisions(PhysicsObject* A, PhysicsObject* B, const CollisionInfo& info);
-
 
     static void SDLCALL OnLoadFileSelected(void* userdata, const char* const* filelist, int filter); 
     static void SDLCALL SaveFile(void* userdata, const char* const* filelist, int filter);
@@ -0,0 +1,727 @@
+#include "PhysicsWorld.h"
+#include "Box.h"
+#include "Circle.h"
+#include "Plane.h"
+#include "ContactConstraint.h"
+#include "ContinuousCollision.h"
+#include "Integrator.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+
+// Milliseconds since lapStart, then starts the next lap.
+static double Lap(std::chrono::steady_clock::time_point& lapStart)
+{
+	const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	const double elapsed = std::chrono::duration<double, std::milli>(now - lapStart).count();
+	lapStart = now;
+	return elapsed;
+}
+
+// Same order as CollisionFunctions, for the profiler.
+static const char* const CollisionFunctionNames[9] = { "Plane2Plane", "Plane2Sphere", "Plane2Box",
+                                                       "Sphere2Plane", "Sphere2Sphere", "Sphere2Box",
+                                                       "Box2Plane", "Box2Sphere", "Box2Box" };
+
+PhysicsWorld::PhysicsWorld(int threadCount) : m_jobs(threadCount)
+{
+	PhysicsObject::bodies = &m_bodies;
+
+	m_broadPhase = BroadPhase::Create(m_broadPhaseType);
+}
+
+PhysicsWorld::~PhysicsWorld()
+{
+	for (const PhysicsObject* actor : m_actors) {
+		delete actor;
+	}
+}
+
+void PhysicsWorld::Simulate(float timeStep)
+{
+	m_bodies.SavePreviousTransforms();
+
+	m_lastSubstepCount = settings.adaptiveSubstepping ? ChooseSubstepCount(timeStep) : 1;
+	const float substep = timeStep / m_lastSubstepCount;
+
+	for (int i = 0; i < m_lastSubstepCount; i++) {
+		Step(substep);
+	}
+}
+
+int PhysicsWorld::ChooseSubstepCount(float timeStep) const
+{
+	// How far (as a fraction of the smallest body's width) anything is allowed to move in one substep.
+	constexpr float MaxTravelFraction = 0.25f;
+
+	float maxSpeedSquared = 0.0f;
+	for (int i = 0; i < m_bodies.GetAwakeCount(); i++) {
+		maxSpeedSquared = std::max(maxSpeedSquared, m_bodies.velocityX[i] * m_bodies.velocityX[i] + m_bodies.velocityY[i] * m_bodies.velocityY[i]);
+	}
+	if (maxSpeedSquared == 0.0f) return 1;
+
+	// NOTE: Worked out every time rather than cached, since the inspector can resize things without the world knowing.
+	float smallestSize = FLT_MAX;
+	for (const PhysicsObject* actor : m_actors) {
+		if (actor->m_ShapeID == ShapeType::BOX) {
+			const Box* box = static_cast<const Box*>(actor);
+			smallestSize = std::min(smallestSize, 2.0f * std::min(box->GetHalfWidth(), box->GetHalfHeight()));
+		}
+		else if (actor->m_ShapeID == ShapeType::CIRCLE) {
+			smallestSize = std::min(smallestSize, 2.0f * static_cast<const Circle*>(actor)->GetRadius());
+		}
+	}
+	if (smallestSize == FLT_MAX || smallestSize <= 0.0f) return 1;
+
+	const float travel = sqrtf(maxSpeedSquared) * timeStep;
+	const int substeps = static_cast<int>(ceilf(travel / (MaxTravelFraction * smallestSize)));
+	return std::clamp(substeps, 1, std::max(settings.maxSubsteps, 1));
+}
+
+void PhysicsWorld::Step(float timeStep)
+{
+	PROFILE_ZONE("PhysicsWorld::Step");
+
+	const std::chrono::steady_clock::time_point stepStart = std::chrono::steady_clock::now();
+	std::chrono::steady_clock::time_point lapStart = stepStart;
+
+	m_contactConstraints.clear();
+
+	if (settings.autoSelectBroadPhase && m_actorsChanged) {
+		AutoSelectBroadPhase();
+	}
+	m_actorsChanged = false;
+
+	// Only pairs whose bounds overlap make it through to the narrow phase.
+	{
+		PROFILE_ZONE("BroadPhase::UpdatePairs");
+		m_broadPhase->UpdatePairs(timeStep, m_broadPhasePairs, settings.speculativeContacts);
+	}
+	m_timings.broadPhase = Lap(lapStart);
+
+	m_collisions.clear();
+	m_sleepingPairs.clear();
+
+	for (const BroadPhasePair& pair : m_broadPhasePairs) {
+
+		// Sleeping (and static) bodies can't have moved, so there's no point checking them against each other.
+		if (!m_bodies.IsAwake(pair.A->GetBodyIndex()) && !m_bodies.IsAwake(pair.B->GetBodyIndex())) {
+			m_sleepingPairs.push_back(pair);
+			continue;
+		}
+
+		TestPair(pair.A, pair.B, timeStep);
+	}
+
+	// Anything that just got woken up needs the contacts with the rest of its island too.
+	// NOTE: If one of these wakes up yet another island, that island will be missing its own contacts for this step.
+	for (const BroadPhasePair& pair : m_sleepingPairs) {
+		if (m_bodies.IsAwake(pair.A->GetBodyIndex()) || m_bodies.IsAwake(pair.B->GetBodyIndex())) {
+			TestPair(pair.A, pair.B, timeStep);
+		}
+	}
+	m_timings.narrowPhase = Lap(lapStart);
+
+	// Create contact constraints. This has to wait until all the waking up is done, since that moves bodies around in the store.
+	for (CollisionInfo& info : m_collisions) {
+		ContactConstraint constraint;
+		constraint.Setup(info, timeStep, m_bodies);
+		// NOTE: Speculative contacts that haven't touched yet can't bounce, or they'd bounce off thin air.
+		constraint.elasticity = constraint.IsSpeculative() ? 0.0f : settings.elasticity;
+		if (settings.warmStarting) m_contactCache.Find(constraint, m_bodies);
+		m_contactConstraints.push_back(constraint);
+	}
+	m_timings.constraintSetup = Lap(lapStart);
+
+	Integrator::IntegrateForces(m_bodies, settings.gravity, timeStep);
+	m_timings.integrate = Lap(lapStart);
+
+	m_islands.Build(m_bodies, m_contactConstraints);
+
+	if (settings.parallelSolve) m_solver.Solve(m_bodies, m_contactConstraints, m_islands, m_jobs, settings.solverIterations);
+	else m_solver.SolveSerial(m_bodies, m_contactConstraints, settings.solverIterations);
+
+	// NOTE: Has to happen before anything goes to sleep, since that moves the bodies around.
+	m_contactCache.Store(m_contactConstraints, m_bodies);
+	m_timings.solve = Lap(lapStart);
+
+	Integrator::IntegrateVelocities(m_bodies, timeStep);
+	m_timings.integrate += Lap(lapStart);
+
+	m_fastBodies.clear();
+	m_sweepHitCount = 0;
+	if (settings.continuousCollision) SolveContinuous(timeStep);
+	m_timings.continuous = Lap(lapStart);
+
+	m_islands.UpdateSleep(m_bodies, timeStep, settings.allowSleeping);
+	m_awakeIslandCount = m_islands.GetAwakeIslandCount();
+	m_timings.sleep = Lap(lapStart);
+
+	m_timings.total = std::chrono::duration<double, std::milli>(lapStart - stepStart).count();
+}
+
+void PhysicsWorld::WakeActor(PhysicsObject* actor)
+{
+	m_islands.WakeBody(m_bodies, actor->GetBodyIndex());
+}
+
+void PhysicsWorld::WakeAll()
+{
+	m_islands.WakeAll(m_bodies);
+}
+
+void PhysicsWorld::TestPair(PhysicsObject* A, PhysicsObject* B, float timeStep)
+{
+	// Speculative pairs make a contact for anything they could close the gap on by the end of the step.
+	// NOTE: Only the linear velocity is counted, so a fast spinning box can still clip a corner through something thin.
+	float margin = 0.0f;
+	if (settings.speculativeContacts && (A->GetSpeculative() || B->GetSpeculative())) {
+		margin = (m_bodies.GetVelocity(A->GetBodyIndex()) - m_bodies.GetVelocity(B->GetBodyIndex())).GetMagnitude() * timeStep;
+	}
+
+	//NOTE: The index for the function pointer array is given by: (A->m_ShapeID * N) + B, where N is the number of shape types.
+	const int index = static_cast<int>(A->m_ShapeID) * 3 + static_cast<int>(B->m_ShapeID);
+	PROFILE_ZONE(CollisionFunctionNames[index]);
+	const CollisionInfo info = CollisionFunctions[index](A, B, margin);
+	if (!info.isColliding) return;
+
+	// Something awake ran into a sleeping body, so wake it (and everything it's resting on) up.
+	m_islands.WakeBody(m_bodies, A->GetBodyIndex());
+	m_islands.WakeBody(m_bodies, B->GetBodyIndex());
+
+	m_collisions.push_back(info);
+}
+
+void PhysicsWorld::SolveContinuous(float timeStep)
+{
+	PROFILE_ZONE("PhysicsWorld::SolveContinuous");
+
+	// How far (as a fraction of its own width) a body can move in one step before the collision functions might miss something.
+	constexpr float FastTravelFraction = 0.5f;
+	// NOTE: Each hit uses up a sweep. If a body is still hitting things after this many, it just stops at the last one.
+	constexpr int MaxSweeps = 4;
+
+	// Pick out the fast bodies first, since resolving a hit can wake things up and shuffle the store around.
+	for (PhysicsObject* actor : m_actors) {
+		if (actor->m_ShapeID == ShapeType::PLANE) continue;
+		if (settings.speculativeContacts && actor->GetSpeculative()) continue;
+
+		const int index = actor->GetBodyIndex();
+		if (!m_bodies.IsAwake(index)) continue;
+
+		float size;
+		if (actor->m_ShapeID == ShapeType::BOX) {
+			const Box* box = static_cast<const Box*>(actor);
+			size = 2.0f * std::min(box->GetHalfWidth(), box->GetHalfHeight());
+		}
+		else {
+			size = 2.0f * static_cast<const Circle*>(actor)->GetRadius();
+		}
+
+		const float boundingRadius = ShapePose::FromObject(actor).GetBoundingRadius();
+		const float travel = (m_bodies.GetVelocity(index).GetMagnitude() + abs(m_bodies.angularVelocity[index]) * boundingRadius) * timeStep;
+		if (travel > FastTravelFraction * size) m_fastBodies.push_back(actor);
+	}
+
+	for (PhysicsObject* actor : m_fastBodies) {
+		const float boundingRadius = ShapePose::FromObject(actor).GetBoundingRadius();
+
+		// NOTE: The integrator just added velocity * timeStep, so the start of the step is easy to get back to.
+		int index = actor->GetBodyIndex();
+		Sweep sweep;
+		sweep.endPosition = m_bodies.GetPosition(index);
+		sweep.endOrientation = m_bodies.orientation[index];
+		sweep.startPosition = sweep.endPosition - timeStep * m_bodies.GetVelocity(index);
+		sweep.startOrientation = sweep.endOrientation - timeStep * m_bodies.angularVelocity[index];
+		float sweepTime = timeStep;
+
+		for (int sweepCount = 0; sweepCount < MaxSweeps; sweepCount++) {
+
+			// Everything else has moved a bit since the broad phase last saw it, so pad the swept bounds by the broad phase's margin.
+			const Vec2 padding = { boundingRadius + AABBMargin, boundingRadius + AABBMargin };
+			const AABB start = { sweep.startPosition - padding, sweep.startPosition + padding };
+			const AABB end = { sweep.endPosition - padding, sweep.endPosition + padding };
+			m_broadPhase->Query(AABB::Combine(start, end), m_sweepCandidates);
+
+			float timeOfImpact = 1.0f;
+			PhysicsObject* hit = nullptr;
+			for (PhysicsObject* other : m_sweepCandidates) {
+				if (other == actor) continue;
+
+				// NOTE: Everything else is treated as sitting still where it ended up this step.
+				const float t = TimeOfImpact(actor, sweep, ShapePose::FromObject(other));
+				if (t < timeOfImpact) {
+					timeOfImpact = t;
+					hit = other;
+				}
+			}
+			if (!hit) break;
+
+			m_sweepHitCount++;
+
+			index = actor->GetBodyIndex();
+			m_bodies.SetPosition(index, sweep.GetPosition(timeOfImpact));
+			m_bodies.orientation[index] = sweep.GetOrientation(timeOfImpact);
+			ResolveImpact(actor, hit, timeStep);
+
+			if (sweepCount + 1 == MaxSweeps) break;
+
+			// Spend whatever is left of the step moving with the new velocity, and check that part too.
+			sweepTime *= 1.0f - timeOfImpact;
+			index = actor->GetBodyIndex();
+			sweep.startPosition = m_bodies.GetPosition(index);
+			sweep.startOrientation = m_bodies.orientation[index];
+			sweep.endPosition = sweep.startPosition + sweepTime * m_bodies.GetVelocity(index);
+			sweep.endOrientation = sweep.startOrientation + sweepTime * m_bodies.angularVelocity[index];
+			m_bodies.SetPosition(index, sweep.endPosition);
+			m_bodies.orientation[index] = sweep.endOrientation;
+		}
+	}
+}
+
+void PhysicsWorld::ResolveImpact(PhysicsObject* A, PhysicsObject* B, float timeStep)
+{
+	// The time of impact stops just past touching, so the normal collision functions give us the contact.
+	const int index = static_cast<int>(A->m_ShapeID) * 3 + static_cast<int>(B->m_ShapeID);
+	CollisionInfo info = CollisionFunctions[index](A, B, 0.0f);
+	if (!info.isColliding) return;
+
+	m_islands.WakeBody(m_bodies, B->GetBodyIndex());
+
+	// NOTE: Only this one contact gets solved, without warm starting. The full solver will pick it up properly next step.
+	ContactConstraint constraint;
+	constraint.Setup(info, timeStep, m_bodies);
+	constraint.elasticity = settings.elasticity;
+	for (int i = 0; i < settings.solverIterations; i++) {
+		constraint.SolveVelocity(m_bodies);
+		constraint.SolveFriction(m_bodies);
+	}
+}
+
+void PhysicsWorld::AddActor(PhysicsObject* actor)
+{
+	m_actors.push_back(actor);
+	m_broadPhase->AddObject(actor);
+	m_actorsChanged = true;
+	m_actorsVersion++;
+}
+
+void PhysicsWorld::RemoveActor(PhysicsObject* actor)
+{
+
+    // NOTE: This could be simplified using smart pointers.
+    
+	// Wake up its island first, otherwise anything resting on it would be left floating.
+	m_islands.WakeBody(m_bodies, actor->GetBodyIndex());
+
+	// The body's handle is about to be freed, and whatever gets it next shouldn't inherit its contacts.
+	m_contactCache.Clear();
+
+	m_broadPhase->RemoveObject(actor);
+	m_actorsChanged = true;
+	m_actorsVersion++;
+
+	auto it = std::remove_if(m_actors.begin(), m_actors.end(), [actor](PhysicsObject* a) {
+		if (a == actor) {
+			delete a;
+			return true;
+		}
+		return false;
+		});
+
+	m_actors.erase(it, m_actors.end());
+}
+
+void PhysicsWorld::ClearAllActors()
+{
+
+    // NOTE: This could be much simpler if I were using smart pointers for the actors.
+	m_broadPhase->Clear();
+	m_islands.Clear();
+	m_contactCache.Clear();
+	m_actorsChanged = true;
+	m_actorsVersion++;
+
+	auto it = std::remove_if(m_actors.begin(), m_actors.end(), [](PhysicsObject* a) {
+		delete a;
+		return true;
+		});
+
+	m_actors.erase(it, m_actors.end());
+}
+
+void PhysicsWorld::SetBroadPhase(BroadPhaseType type)
+{
+	// Build the new broad phase from scratch, since none of them share any state.
+	m_broadPhaseType = type;
+	m_broadPhase = BroadPhase::Create(type);
+
+	for (PhysicsObject* actor : m_actors) {
+		m_broadPhase->AddObject(actor);
+	}
+}
+
+void PhysicsWorld::AutoSelectBroadPhase()
+{
+	// NOTE: The grid only wins when everything is about the same size. The gap between the two thresholds stops us rebuilding
+	// the broad phase back and forth when a scene sits right on the edge.
+	const float enterGridVariation = 0.15f;
+	const float exitGridVariation = 0.3f;
+
+	const float variation = BroadPhase::GetSizeVariation(m_actors);
+
+	if (m_broadPhaseType != BroadPhaseType::SPATIAL_HASH && variation < enterGridVariation) {
+		SetBroadPhase(BroadPhaseType::SPATIAL_HASH);
+	}
+	else if (m_broadPhaseType == BroadPhaseType::SPATIAL_HASH && variation > exitGridVariation) {
+		SetBroadPhase(BroadPhaseType::AABB_TREE);
+	}
+}
+
+
+// NOTE: These collision functions return the collision normal from B to A. This is unconvential, and I only realised this when I had finished making the first half of these functions. 
+// This shouldn't cause any ununsual behaviour (the collision resolution function is consisent with this normal direction), but it is something to be aware of. 
+
+CollisionInfo PhysicsWorld::Sphere2Plane(PhysicsObject* A, PhysicsObject* B, float margin) {
+
+	// NOTE: For circle-plane collisions, the collision normal will be either -planeNormal or planeNormal. 
+
+	CollisionInfo info;
+	const Circle* CircleA = static_cast<Circle*>(A);
+	const Plane* PlaneB = static_cast<Plane*>(B);
+
+	if (abs(Dot(CircleA->GetPosition(), PlaneB->GetNormal()) - PlaneB->GetDistance()) <= CircleA->GetRadius() + margin) {
+		info.isColliding = true;
+
+		const float distanceToPlane = Dot(CircleA->GetPosition(), PlaneB->GetNormal()) - PlaneB->GetDistance();
+		info.collisionNormal = (distanceToPlane > 0) ? PlaneB->GetNormal() : -1.0f * PlaneB->GetNormal();
+		info.AddPoint(CircleA->GetPosition() + CircleA->GetRadius() * info.collisionNormal, CircleA->GetRadius() - abs(distanceToPlane));
+		info.A = A;
+		info.B = B;
+	}
+	return info;
+
+}
+
+CollisionInfo PhysicsWorld::Plane2Sphere(PhysicsObject* A, PhysicsObject* B, float margin) {
+
+	// NOTE: For circle-plane collisions, the collision normal will be either -planeNormal or planeNormal. 
+
+	CollisionInfo info;
+	const Plane* PlaneA = static_cast<Plane*>(A);
+	const Circle* CircleB = static_cast<Circle*>(B);
+
+	if (abs(Dot(CircleB->GetPosition(), PlaneA->GetNormal()) - PlaneA->GetDistance()) <= CircleB->GetRadius() + margin) {
+		info.isColliding = true;
+
+		// Get normal direction
+		const float distanceToPlane = Dot(CircleB->GetPosition(), PlaneA->GetNormal()) - PlaneA->GetDistance();
+		info.collisionNormal = (distanceToPlane > 0) ? -1.0f * PlaneA->GetNormal() : PlaneA->GetNormal();
+		info.AddPoint(CircleB->GetPosition() + CircleB->GetRadius() * info.collisionNormal, CircleB->GetRadius() - abs(distanceToPlane));
+		info.A = A;
+		info.B = B;
+	}
+
+	return info;
+}
+
+
+CollisionInfo PhysicsWorld::Sphere2Sphere(PhysicsObject* A, PhysicsObject* B, float margin) {
+
+	CollisionInfo info;
+
+	const Circle* CircleA = static_cast<Circle*>(A);
+	const Circle* CircleB = static_cast<Circle*>(B);
+
+	const float reach = CircleA->GetRadius() + CircleB->GetRadius() + margin;
+	if ((CircleA->GetPosition() - CircleB->GetPosition()).GetMagnitudeSquared() < reach * reach) {
+		info.isColliding = true;
+		info.collisionNormal = (CircleA->GetPosition() - CircleB->GetPosition()).Normalise();
+		info.AddPoint(CircleB->GetPosition() + CircleB->GetRadius() * info.collisionNormal, (CircleA->GetRadius() + CircleB->GetRadius()) - (CircleA->GetPosition() - CircleB->GetPosition()).GetMagnitude());
+		info.A = A;
+		info.B = B;
+
+
+	}
+
+	return info;
+}
+
+CollisionInfo PhysicsWorld::Plane2Plane(PhysicsObject*, PhysicsObject*, float) {
+	return CollisionInfo();
+}
+
+// A box as a polygon: the corners go anticlockwise, and normals[i] is the outward normal of the edge from vertices[i] to vertices[i + 1].
+struct BoxPolygon {
+	Vec2 vertices[4];
+	Vec2 normals[4];
+};
+
+static BoxPolygon MakeBoxPolygon(Box* box)
+{
+	box->UpdateLocalAxes();
+	const Vec2 centre = box->GetPosition();
+	const Vec2 x = box->GetLocalXAxis() * box->GetHalfWidth();
+	const Vec2 y = box->GetLocalYAxis() * box->GetHalfHeight();
+
+	return { { centre - x - y, centre + x - y, centre + x + y, centre - x + y },
+			 { -1.0f * box->GetLocalYAxis(), box->GetLocalXAxis(), box->GetLocalYAxis(), -1.0f * box->GetLocalXAxis() } };
+}
+
+// The edge of the box facing most directly against the normal.
+static int FindIncidentEdge(const BoxPolygon& box, Vec2 normal)
+{
+	int edge = 0;
+	float lowest = FLT_MAX;
+	for (int i = 0; i < 4; i++) {
+		const float facing = Dot(box.normals[i], normal);
+		if (facing < lowest) {
+			lowest = facing;
+			edge = i;
+		}
+	}
+	return edge;
+}
+
+CollisionInfo PhysicsWorld::Box2Plane(PhysicsObject* A, PhysicsObject* B, float margin) {
+
+	CollisionInfo info;
+	Box* BoxA = static_cast<Box*>(A);
+	const Plane* PlaneB = static_cast<Plane*>(B);
+
+	// NOTE: Planes are two-sided, so use whichever side the box's centre is on.
+	const float distance = Dot(BoxA->GetPosition(), PlaneB->GetNormal()) - PlaneB->GetDistance();
+	const Vec2 normal = distance > 0 ? PlaneB->GetNormal() : -1.0f * PlaneB->GetNormal();
+	const float planeOffset = distance > 0 ? PlaneB->GetDistance() : -PlaneB->GetDistance();
+
+	// The plane is the reference face, and it's infinite, so there's nothing to clip the box's incident edge against. Each end of
+	// the edge is a contact point if it's close enough.
+	const BoxPolygon box = MakeBoxPolygon(BoxA);
+	const int edge = FindIncidentEdge(box, normal);
+
+	for (const int vertex : { edge, (edge + 1) % 4 }) {
+		const float separation = Dot(box.vertices[vertex], normal) - planeOffset;
+		if (separation > margin) continue;
+
+		info.AddPoint(box.vertices[vertex], -separation, static_cast<uint32_t>(vertex));
+	}
+
+	if (info.pointCount == 0) return info;
+
+	info.isColliding = true;
+	info.collisionNormal = normal;
+	info.A = A;
+	info.B = B;
+	return info;
+}
+
+CollisionInfo PhysicsWorld::Plane2Box(PhysicsObject* A, PhysicsObject* B, float margin) {
+
+	// Same contact as the other way around, with the normal flipped to keep pointing from B to A.
+	CollisionInfo info = Box2Plane(B, A, margin);
+	info.collisionNormal = -1.0f * info.collisionNormal;
+	info.A = A;
+	info.B = B;
+	return info;
+}
+
+CollisionInfo PhysicsWorld::Box2Sphere(PhysicsObject* A, PhysicsObject* B, float margin) {
+	CollisionInfo info;
+	Box* BoxA = static_cast<Box*>(A);
+	const Circle* CircleB = static_cast<Circle*>(B);
+
+	BoxA->UpdateLocalAxes();
+
+	//NOTE: Here we transform the Circle so that it is in OBB's local axes with the OBB centered at the origin.
+	const Vec2 RelativePos = CircleB->GetPosition() - BoxA->GetPosition();
+
+	Vec2 CirclePos;
+
+	CirclePos.x = Dot(RelativePos, BoxA->GetLocalXAxis());
+	CirclePos.y = Dot(RelativePos, BoxA->GetLocalYAxis());
+
+	// Get position on box that is closet to circle.
+	const Vec2 closest = { Clamp<float>(CirclePos.x, -BoxA->GetHalfWidth(),BoxA->GetHalfWidth()),
+	Clamp<float>(CirclePos.y,-BoxA->GetHalfHeight(),BoxA->GetHalfHeight()) };
+
+	const float distance = (closest - CirclePos).GetMagnitude();
+
+	if (distance <= CircleB->GetRadius() + margin) {
+		info.isColliding = true;
+		const Vec2 collisionNormalLocal = (closest - CirclePos).Normalise();
+		info.collisionNormal = (BoxA->GetLocalXAxis() * collisionNormalLocal.x) + (BoxA->GetLocalYAxis() * collisionNormalLocal.y);
+		info.AddPoint((CircleB->GetPosition() + CircleB->GetRadius() * info.collisionNormal), CircleB->GetRadius() - distance);
+ 		info.A = A;
+		info.B = B;
+	}
+	return info;
+}
+
+CollisionInfo PhysicsWorld::Sphere2Box(PhysicsObject* A, PhysicsObject* B, float margin) {
+
+	CollisionInfo info;
+	Box* BoxB = static_cast<Box*>(B);
+	const Circle* CircleA = static_cast<Circle*>(A);
+
+	//NOTE: Here we transform the Circle so that it is in OBB's local axes with the OBB centered at the origin.
+	BoxB->UpdateLocalAxes();
+	const Vec2 RelativePos = CircleA->GetPosition() - BoxB->GetPosition();
+
+	Vec2 CirclePos;
+
+	CirclePos.x = Dot(RelativePos, BoxB->GetLocalXAxis());
+	CirclePos.y = Dot(RelativePos, BoxB->GetLocalYAxis());
+
+	// Get position on box that is closet to circle.
+	const Vec2 closest = { Clamp<float>(CirclePos.x, -BoxB->GetHalfWidth(),BoxB->GetHalfWidth()),
+	Clamp<float>(CirclePos.y,-BoxB->GetHalfHeight(),BoxB->GetHalfHeight()) };
+
+	const float distance = (closest - CirclePos).GetMagnitude();
+
+	if (distance <= CircleA->GetRadius() + margin) {
+		info.isColliding = true;
+		const Vec2 collisionNormalLocal = (CirclePos - closest).Normalise();
+		info.collisionNormal = (BoxB->GetLocalXAxis() * collisionNormalLocal.x) + (BoxB->GetLocalYAxis() * collisionNormalLocal.y);
+		info.AddPoint((CircleA->GetPosition() - CircleA->GetRadius() * info.collisionNormal), CircleA->GetRadius() - distance);
+		info.A = A;
+		info.B = B;
+
+	}
+	return info;
+}
+
+// Biggest gap between the two boxes along any of the first one's face normals, and which face it's along.
+static float FindMaxSeparation(const BoxPolygon& a, const BoxPolygon& b, int& edge)
+{
+	float best = -FLT_MAX;
+	for (int i = 0; i < 4; i++) {
+		float deepest = FLT_MAX;
+		for (int j = 0; j < 4; j++) {
+			deepest = std::min(deepest, Dot(a.normals[i], b.vertices[j] - a.vertices[i]));
+		}
+
+		if (deepest > best) {
+			best = deepest;
+			edge = i;
+		}
+	}
+	return best;
+}
+
+struct ClipVertex {
+	Vec2 position;
+	// Which incident vertex this is (0 to 3), or which side of the reference face cut it (4 or 5).
+	uint32_t id;
+};
+
+// Keeps whatever part of the segment has Dot(normal, p) <= offset. Returns how many of the two vertices are left.
+static int ClipSegment(ClipVertex out[2], const ClipVertex in[2], Vec2 normal, float offset, uint32_t clipID)
+{
+	const float distance0 = Dot(normal, in[0].position) - offset;
+	const float distance1 = Dot(normal, in[1].position) - offset;
+
+	int count = 0;
+	if (distance0 <= 0.0f) out[count++] = in[0];
+	if (distance1 <= 0.0f) out[count++] = in[1];
+
+	if (distance0 * distance1 < 0.0f) {
+		const float t = distance0 / (distance0 - distance1);
+		out[count++] = { in[0].position + t * (in[1].position - in[0].position), clipID };
+	}
+	return count;
+}
+
+CollisionInfo PhysicsWorld::Box2Box(PhysicsObject* A, PhysicsObject* B, float margin) {
+
+	CollisionInfo info;
+	const BoxPolygon polygonA = MakeBoxPolygon(static_cast<Box*>(A));
+	const BoxPolygon polygonB = MakeBoxPolygon(static_cast<Box*>(B));
+
+	// SAT, but keeping track of which face the best axis came from.
+	int edgeA = 0;
+	const float separationA = FindMaxSeparation(polygonA, polygonB, edgeA);
+	if (separationA > margin) return info;
+
+	int edgeB = 0;
+	const float separationB = FindMaxSeparation(polygonB, polygonA, edgeB);
+	if (separationB > margin) return info;
+
+	// The face with the smallest overlap becomes the reference face, and the other box's edge that faces it the most is clipped
+	// against it. A's face wins ties, so a box stacked on another doesn't keep swapping which face it uses (and losing its
+	// warm starting).
+	const float flipTolerance = 0.0005f;
+	const bool flip = separationB > separationA + flipTolerance;
+
+	const BoxPolygon& reference = flip ? polygonB : polygonA;
+	const BoxPolygon& incident = flip ? polygonA : polygonB;
+	const int referenceEdge = flip ? edgeB : edgeA;
+	const Vec2 normal = reference.normals[referenceEdge];
+
+	const int incidentEdge = FindIncidentEdge(incident, normal);
+	const ClipVertex incidentVertices[2] = { { incident.vertices[incidentEdge], static_cast<uint32_t>(incidentEdge) },
+											 { incident.vertices[(incidentEdge + 1) % 4], static_cast<uint32_t>((incidentEdge + 1) % 4) } };
+
+	// Cut the incident edge down to the part that's alongside the reference face.
+	const Vec2 start = reference.vertices[referenceEdge];
+	const Vec2 end = reference.vertices[(referenceEdge + 1) % 4];
+	const Vec2 tangent = (end - start).GetNormalised();
+
+	ClipVertex clippedStart[2];
+	ClipVertex clipped[2];
+	if (ClipSegment(clippedStart, incidentVertices, -1.0f * tangent, -Dot(tangent, start), 4) < 2) return info;
+	if (ClipSegment(clipped, clippedStart, tangent, Dot(tangent, end), 5) < 2) return info;
+
+	// Whatever's left behind the reference face (or within the margin of it) is a contact point.
+	// NOTE: The feature ID packs which face is the reference, which incident edge is being clipped and which vertex this is, so it
+	// stays the same while the boxes stay touching the same way.
+	const float frontOffset = Dot(normal, start);
+	for (const ClipVertex& vertex : clipped) {
+		const float separation = Dot(normal, vertex.position) - frontOffset;
+		if (separation > margin) continue;
+
+		const uint32_t featureID = (flip ? 1u << 12 : 0u) | (static_cast<uint32_t>(referenceEdge) << 8) | (static_cast<uint32_t>(incidentEdge) << 4) | vertex.id;
+
+		// Put the point halfway between the two surfaces, so neither box gets more of the torque than the other.
+		info.AddPoint(vertex.position - 0.5f * separation * normal, -separation, featureID);
+	}
+
+	if (info.pointCount == 0) return info;
+
+	// NOTE: The reference normal points out of the reference box, and the normal we return points from B to A.
+	info.isColliding = true;
+	info.collisionNormal = flip ? normal : -1.0f * normal;
+	info.A = A;
+	info.B = B;
+	return info;
+}
+
+
+//void PhysicsWorld::ResolveCollisions(PhysicsObject* A, PhysicsObject* B, const CollisionInfo& info) {
+//
+//	float e = 0.5f;
+//	Vec2 rA = info.collisionPoint - A->GetPosition();
+//	Vec2 rB = info.collisionPoint - B->GetPosition();
+//
+//	float rACrossN = PseudoCross(rA, info.collisionNormal);
+//	float rBCrossN = PseudoCross(rB, info.collisionNormal);
+//
+//	Vec2 relativeVelocity = (A->GetVelocity() + PseudoCross(rA, A->GetAngularVelocity()))
+//		- (B->GetVelocity() + PseudoCross(rB, B->GetAngularVelocity()));
+//
+//	if (Dot(relativeVelocity, info.collisionNormal) < 0) {
+//		if (m_debugShowContactPoints) lines->DrawCircle(info.collisionPoint, 0.05f, Colour::RED);
+//		float impulseMagnitude = -(1 + elasticity) * (Dot(relativeVelocity, info.collisionNormal)) /
+//			(A->GetInverseMass() + B->GetInverseMass() + (rACrossN * rACrossN) * A->GetInverseMoment() + (rBCrossN * rBCrossN) * B->GetInverseMoment());
+//		A->ApplyImpulse(impulseMagnitude * info.collisionNormal, info.collisionPoint);
+//		B->ApplyImpulse(-1.0f * impulseMagnitude * info.collisionNormal, info.collisionPoint);
+//	}
+//
+//	const float totalInverseMass = A->GetInverseMass() + B->GetInverseMass();
+//	if (totalInverseMass > 0.0f) {
+//		const Vec2 correction = (info.penetrationDepth / totalInverseMass) * info.collisionNormal;
+//		A->SetPosition(A->GetPosition() + A->GetInverseMass() * correction);
+//		B->SetPosition(B->GetPosition() - B->GetInverseMass() * correction);
+//	}
+//
+//}
@@ -0,0 +1,171 @@
+#pragma once
+
+#include "PhysicsObject.h"
+#include "BroadPhase.h"
+#include "IslandManager.h"
+#include "ContactSolver.h"
+#include "ContactCache.h"
+#include "CollisionInfo.h"
+#include "JobSystem.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Everything that can be tweaked between steps. The scene's debug options edit these directly.
+struct WorldSettings {
+    Vec2 gravity = { 0.0f, -9.81f };
+    float elasticity = 0.3f;
+
+    // NOTE: Turning sleeping off doesn't wake anything up by itself, call PhysicsWorld::WakeAll() as well.
+    bool allowSleeping = true;
+
+    // Islands get solved across every core. Turning this off solves every contact in order on the calling thread.
+    bool parallelSolve = true;
+
+    // Starts the solver from last step's impulses, so it doesn't have to start from scratch every step.
+    bool warmStarting = true;
+    int solverIterations = 10;
+
+    // When set, switches to the spatial hash grid whenever the actors are all roughly the same size.
+    bool autoSelectBroadPhase = true;
+
+    // When set, Simulate() splits the step up whenever the fastest body would move more than a fraction of the smallest body's
+    // size in one go, up to maxSubsteps pieces.
+    bool adaptiveSubstepping = false;
+    int maxSubsteps = 8;
+
+    // When set, bodies that move more than a fraction of their own width in one step get swept from where they started to where
+    // they ended up, and stopped at the first thing they would have hit. Only those bodies pay for it, so the step rate can stay
+    // the same for everything else.
+    bool continuousCollision = true;
+
+    // The cheaper option for projectiles. Pairs with a speculative body (see PhysicsObject::SetSpeculative()) make contacts as soon
+    // as they're close enough to touch this step, and the solver only lets them close the gap rather than push through it.
+    // Speculative bodies skip the continuous collision sweep.
+    bool speculativeContacts = true;
+};
+
+// How long each part of the last step took, in milliseconds.
+struct StepTimings {
+    double broadPhase = 0.0;
+    double narrowPhase = 0.0;
+    double constraintSetup = 0.0;
+    double solve = 0.0;
+    double integrate = 0.0;
+    double continuous = 0.0;
+    double sleep = 0.0;
+    double total = 0.0;
+};
+
+// The simulation itself: the bodies, the actors that own them, and everything needed to step them forward. None of this knows
+// about windows, rendering or ImGui, so it can run headless. PhysicsScene wraps one of these with the editor UI.
+//
+// NOTE: The world owns its actors, and deletes them when they're removed.
+class PhysicsWorld
+{
+public:
+    // The thread count includes the calling thread. 0 means one thread per core.
+    explicit PhysicsWorld(int threadCount = 0);
+    ~PhysicsWorld();
+    PhysicsWorld(const PhysicsWorld& other) = delete;
+    PhysicsWorld& operator=(const PhysicsWorld& other) = delete;
+
+    // Moves the world forward by timeStep in one step, whatever the settings say.
+    void Step(float timeStep);
+
+    // Moves the world forward by timeStep, in as many substeps as adaptive substepping asks for. Also remembers where everything
+    // was beforehand, for drawing in between.
+    void Simulate(float timeStep);
+    [[nodiscard]] int GetLastSubstepCount() const { return m_lastSubstepCount; }
+
+    // How many bodies were fast enough to be swept last step, and how many times a sweep hit something.
+    [[nodiscard]] int GetLastSweptCount() const { return static_cast<int>(m_fastBodies.size()); }
+    [[nodiscard]] int GetLastSweepHitCount() const { return m_sweepHitCount; }
+
+    void AddActor(PhysicsObject* actor);
+    void RemoveActor(PhysicsObject* actor);
+    void ClearAllActors();
+
+    // Wakes the actor's whole island, e.g. after it has been moved by hand.
+    void WakeActor(PhysicsObject* actor);
+    void WakeAll();
+
+    void SetBroadPhase(BroadPhaseType type);
+    [[nodiscard]] BroadPhaseType GetBroadPhaseType() const { return m_broadPhaseType; }
+
+    [[nodiscard]] const std::vector<PhysicsObject*>& GetActors() const { return m_actors; }
+    // Goes up every time an actor is added or removed.
+    [[nodiscard]] uint64_t GetActorsVersion() const { return m_actorsVersion; }
+    [[nodiscard]] const BodyStore& GetBodies() const { return m_bodies; }
+    [[nodiscard]] const std::vector<ContactConstraint>& GetContacts() const { return m_contactConstraints; }
+
+    [[nodiscard]] int GetAwakeIslandCount() const { return m_awakeIslandCount; }
+    [[nodiscard]] int GetSleepingIslandCount() const { return m_islands.GetSleepingIslandCount(); }
+    [[nodiscard]] int GetThreadCount() const { return m_jobs.GetThreadCount(); }
+    [[nodiscard]] ContactSolver& GetSolver() { return m_solver; }
+    [[nodiscard]] const StepTimings& GetTimings() const { return m_timings; }
+
+    WorldSettings settings;
+
+    // Shapes further apart than margin aren't colliding. Anything closer comes back as a contact, with a negative penetration
+    // depth if there's still a gap (see WorldSettings::speculativeContacts).
+	typedef CollisionInfo (*CollisionFunction)(PhysicsObject*, PhysicsObject*, float margin);
+    //index = (A->m_ShapeID * N) + B
+	CollisionFunction CollisionFunctions[9] = {Plane2Plane, Plane2Sphere, Plane2Box,
+                                               Sphere2Plane, Sphere2Sphere, Sphere2Box,
+                                                Box2Plane, Box2Sphere, Box2Box};
+
+    static CollisionInfo Sphere2Sphere(PhysicsObject* A, PhysicsObject* B, float margin = 0.0f);
+    static CollisionInfo Sphere2Plane(PhysicsObject* A, PhysicsObject* B, float margin = 0.0f);
+    static CollisionInfo Sphere2Box(PhysicsObject* A, PhysicsObject* B, float margin = 0.0f);
+
+    static CollisionInfo Plane2Sphere(PhysicsObject* A, PhysicsObject* B, float margin = 0.0f);
+    static CollisionInfo Plane2Plane(PhysicsObject* A, PhysicsObject* B, float margin = 0.0f);
+    static CollisionInfo Plane2Box(PhysicsObject* A, PhysicsObject* B, float margin = 0.0f);
+
+    static CollisionInfo Box2Plane(PhysicsObject* A, PhysicsObject* B, float margin = 0.0f);
+    static CollisionInfo Box2Sphere(PhysicsObject* A, PhysicsObject* B, float margin = 0.0f);
+    static CollisionInfo Box2Box(PhysicsObject* A, PhysicsObject* B, float margin = 0.0f);
+
+private:
+    // Runs the narrow phase on a pair, waking up either body if they're touching.
+    void TestPair(PhysicsObject* A, PhysicsObject* B, float timeStep);
+
+    // Continuous collision for anything moving fast enough to tunnel. Runs after the positions have been integrated.
+    void SolveContinuous(float timeStep);
+    // Bounces a swept body off whatever it hit, once it has been moved back to the time of impact.
+    void ResolveImpact(PhysicsObject* A, PhysicsObject* B, float timeStep);
+    void AutoSelectBroadPhase();
+
+	// NOTE: The actors are views into this, so it has to outlive them.
+	BodyStore m_bodies;
+	std::vector<PhysicsObject*> m_actors;
+
+    std::vector<ContactConstraint> m_contactConstraints;
+    std::vector<CollisionInfo> m_collisions;
+
+    IslandManager m_islands;
+    int m_awakeIslandCount = 0;
+
+    // Pairs where both bodies were asleep, in case one of them gets woken up later in the same step.
+    std::vector<BroadPhasePair> m_sleepingPairs;
+
+    JobSystem m_jobs;
+    ContactSolver m_solver;
+    ContactCache m_contactCache;
+
+    std::unique_ptr<BroadPhase> m_broadPhase;
+    BroadPhaseType m_broadPhaseType = BroadPhaseType::AABB_TREE;
+    bool m_actorsChanged = false;
+    uint64_t m_actorsVersion = 0;
+    std::vector<BroadPhasePair> m_broadPhasePairs;
+
+    int ChooseSubstepCount(float timeStep) const;
+
+    std::vector<PhysicsObject*> m_fastBodies;
+    std::vector<PhysicsObject*> m_sweepCandidates;
+    int m_sweepHitCount = 0;
+
+    StepTimings m_timings;
+    int m_lastSubstepCount = 1;
+};
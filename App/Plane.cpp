@@ -1,27 +1,24 @@
 #include "Plane.h"
+#include <cfloat>
 
-Plane::Plane() : PhysicsObject(ShapeType::PLANE)
+// NOTE: Planes still get a body (sitting at the origin, with no inverse mass or moment) so the solver can treat every contact
+// the same way, without checking for planes.
+Plane::Plane() : PhysicsObject(ShapeType::PLANE, { 0.0f, 0.0f }, { 0.0f, 0.0f }, 0.0f, 0.0f, 0.0f)
 {
 	m_distanceToOrigin = 0;
 	m_normal = { 0, 1 };
 }
 
-Plane::Plane(const Vec2 normal, const float distance) : PhysicsObject(ShapeType::PLANE), m_normal(normal), m_distanceToOrigin(distance)
+Plane::Plane(const Vec2 normal, const float distance) : PhysicsObject(ShapeType::PLANE, { 0.0f, 0.0f }, { 0.0f, 0.0f }, 0.0f, 0.0f, 0.0f), m_normal(normal), m_distanceToOrigin(distance)
 {
 	// Normalise normal just in case
 	m_normal.Normalise();
 }
 
-void Plane::Draw()
+AABB Plane::GetAABB() const
 {
-	const Vec2 PlaneCenter = m_distanceToOrigin * m_normal;
-	
-	// Get line directions
-	const Vec2 dir1 = m_normal.GetRotatedBy90();
-	const Vec2 dir2 = m_normal.GetRotatedBy270();
-	
-	lines->DrawLineSegment(PlaneCenter, PlaneCenter + 25 * dir1);
-	lines->DrawLineSegment(PlaneCenter, PlaneCenter + 25 * dir2);
+	// NOTE: Planes are infinite, so the broad phase keeps them out of the tree and never asks for this.
+	return { { -FLT_MAX, -FLT_MAX }, { FLT_MAX, FLT_MAX } };
 }
 
 void Plane::ResetPosition()
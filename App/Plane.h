@@ -7,23 +7,10 @@ public:
 	Plane();
 	Plane(Vec2 normal, float distance);
 	//void FixedUpdate(Vec2 gravity, float timeStep) override;
-	void Draw() override;
 	void ResetPosition() override;
-    [[nodiscard]] float GetInverseMass() const override {return 0.0f;}
-    [[nodiscard]] Vec2 GetVelocity() const override {return {0.0f, 0.0f};}
 	[[nodiscard]] Vec2 GetNormal() const { return m_normal; }
 	[[nodiscard]] float GetDistance() const { return m_distanceToOrigin; }
-    void SetPosition(const Vec2 position) override { }
-	void SetOrientation(const float orientation) override {}
-    [[nodiscard]] Vec2 GetPosition() const override {return {0,0};}
-	[[nodiscard]] float GetAngularVelocity() const override { return 0.0f; }
-	[[nodiscard]] float GetInverseMoment() const override{ return 0.0f; }
-    [[nodiscard]] float GetOrientation() const override {return 0.0f;}
-	void ApplyImpulse(const Vec2 impulse) override { return; };
-	void ApplyImpulse(const Vec2 impulse, const Vec2 contactpoint) override { return;  }
-
-	void IntegrateForces(Vec2 gravity, float timeStep) override { return; }
-	void IntegrateVelocity(float timeStep) override { return;  }
+	[[nodiscard]] AABB GetAABB() const override;
 
 protected:
 	Vec2 m_normal;
@@ -0,0 +1,137 @@
+#include "ProfilerPanel.h"
+#include "imgui.h"
+#include <algorithm>
+#include <string_view>
+#include <vector>
+
+constexpr float FlameRowHeight = 18.0f;
+
+void ProfilerPanel::Draw()
+{
+	ImGui::Begin("Profiler");
+
+#ifndef ENGINE_PROFILER
+	ImGui::TextUnformatted("Built without ENGINE_PROFILER, so there are no zones to show.");
+#else
+	bool recording = Profiler::IsEnabled();
+	if (ImGui::Checkbox("Record", &recording)) {
+		Profiler::SetEnabled(recording);
+	}
+	ImGui::SameLine();
+	if (ImGui::Checkbox("Pause", &m_paused) && m_paused) {
+		m_pausedFrame = Profiler::GetLastFrame();
+	}
+
+	const ProfileFrame& frame = m_paused ? m_pausedFrame : Profiler::GetLastFrame();
+	if (!m_paused && frame.end != m_lastFrameEnd) {
+		UpdateHistory(frame);
+		m_lastFrameEnd = frame.end;
+	}
+
+	ImGui::Text("Frame: %.3f ms", (frame.end - frame.start) / 1000000.0);
+
+	if (ImGui::CollapsingHeader("Flame Graph", ImGuiTreeNodeFlags_DefaultOpen)) {
+		DrawFlameGraph(frame);
+	}
+
+	if (ImGui::CollapsingHeader("Zones", ImGuiTreeNodeFlags_DefaultOpen)) {
+		DrawZoneTable();
+	}
+#endif
+
+	ImGui::End();
+}
+
+void ProfilerPanel::UpdateHistory(const ProfileFrame& frame)
+{
+	for (auto& [name, zone] : m_zones) {
+		zone.lastFrame = 0.0;
+		zone.calls = 0;
+	}
+
+	for (const ProfileThread& thread : frame.threads) {
+		for (const ProfileZone& zone : thread.zones) {
+			ZoneHistory& history = m_zones[zone.name];
+			history.lastFrame += (zone.end - zone.start) / 1000000.0;
+			history.calls++;
+		}
+	}
+
+	// Zones that didn't run this frame still need a zero pushed, otherwise their average would never drop.
+	for (auto& [name, zone] : m_zones) {
+		zone.sum += zone.lastFrame - zone.milliseconds[m_historyCursor];
+		zone.milliseconds[m_historyCursor] = zone.lastFrame;
+	}
+	m_historyCursor = (m_historyCursor + 1) % HistoryLength;
+}
+
+void ProfilerPanel::DrawFlameGraph(const ProfileFrame& frame) const
+{
+	ImDrawList* drawList = ImGui::GetWindowDrawList();
+	const float width = ImGui::GetContentRegionAvail().x;
+	const double frameLength = static_cast<double>(std::max<uint64_t>(frame.end - frame.start, 1));
+
+	for (const ProfileThread& thread : frame.threads) {
+		ImGui::TextUnformatted(thread.name.c_str());
+
+		const ImVec2 origin = ImGui::GetCursorScreenPos();
+		int maxDepth = 0;
+
+		for (const ProfileZone& zone : thread.zones) {
+			maxDepth = std::max(maxDepth, zone.depth);
+
+			// NOTE: Zones that started last frame (or are still going) get clamped to this one.
+			const double start = std::clamp((static_cast<double>(zone.start) - frame.start) / frameLength, 0.0, 1.0);
+			const double end = std::clamp((static_cast<double>(zone.end) - frame.start) / frameLength, 0.0, 1.0);
+
+			const ImVec2 min = { origin.x + static_cast<float>(start) * width, origin.y + zone.depth * FlameRowHeight };
+			const ImVec2 max = { std::max(origin.x + static_cast<float>(end) * width, min.x + 1.0f), min.y + FlameRowHeight - 1.0f };
+
+			const size_t hash = std::hash<std::string_view>{}(zone.name);
+			drawList->AddRectFilled(min, max, ImColor::HSV((hash % 360) / 360.0f, 0.5f, 0.7f));
+
+			if (max.x - min.x > 20.0f) {
+				drawList->PushClipRect(min, max, true);
+				drawList->AddText({ min.x + 2.0f, min.y + 1.0f }, IM_COL32_WHITE, zone.name);
+				drawList->PopClipRect();
+			}
+
+			if (ImGui::IsMouseHoveringRect(min, max)) {
+				ImGui::SetTooltip("%s: %.3f ms", zone.name, (zone.end - zone.start) / 1000000.0);
+			}
+		}
+
+		ImGui::Dummy({ width, (maxDepth + 1) * FlameRowHeight });
+	}
+}
+
+void ProfilerPanel::DrawZoneTable() const
+{
+	std::vector<std::pair<const std::string*, const ZoneHistory*>> sorted;
+	for (const auto& [name, zone] : m_zones) {
+		sorted.push_back({ &name, &zone });
+	}
+	std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) { return a.second->sum > b.second->sum; });
+
+	if (ImGui::BeginTable("ProfilerZones", 4, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp)) {
+		ImGui::TableSetupColumn("Zone");
+		ImGui::TableSetupColumn("Last (ms)");
+		ImGui::TableSetupColumn("Average (ms)");
+		ImGui::TableSetupColumn("Calls");
+		ImGui::TableHeadersRow();
+
+		for (const auto& [name, zone] : sorted) {
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::TextUnformatted(name->c_str());
+			ImGui::TableNextColumn();
+			ImGui::Text("%.3f", zone->lastFrame);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.3f", zone->sum / HistoryLength);
+			ImGui::TableNextColumn();
+			ImGui::Text("%d", zone->calls);
+		}
+
+		ImGui::EndTable();
+	}
+}
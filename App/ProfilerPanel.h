@@ -0,0 +1,37 @@
+#pragma once
+#include "Profiler.h"
+#include <array>
+#include <string>
+#include <unordered_map>
+
+// The "Profiler" window: a flame graph of the last frame for every thread, and a table of how long each zone took, averaged over
+// the last couple of seconds. Nothing is recorded unless "Record" is ticked.
+class ProfilerPanel {
+public:
+	void Draw();
+
+private:
+	static constexpr int HistoryLength = 120;
+
+	struct ZoneHistory {
+		std::array<double, HistoryLength> milliseconds{};
+		double sum = 0.0;
+		double lastFrame = 0.0;
+		int calls = 0;
+	};
+
+	void UpdateHistory(const ProfileFrame& frame);
+	void DrawFlameGraph(const ProfileFrame& frame) const;
+	void DrawZoneTable() const;
+
+	// Keyed by name rather than pointer, since the same literal can end up with a different address in each file.
+	std::unordered_map<std::string, ZoneHistory> m_zones;
+	int m_historyCursor = 0;
+
+	// NOTE: The harness only calls Update (and so Draw) once a frame, but this makes sure a frame only ever gets counted once
+	// even if Draw runs again before the next Profiler::EndFrame().
+	uint64_t m_lastFrameEnd = 0;
+
+	bool m_paused = false;
+	ProfileFrame m_pausedFrame;
+};
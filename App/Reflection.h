@@ -2,9 +2,8 @@
 #include <memory>
 #include <vector>
 #include "Vec2.h"
-#include "imgui.h"
 #include <string>
-#include <cstdint>
+#include <typeinfo>
 
 // Useful Macros
 #define BEGIN_REFLECTION(TYPE) \
@@ -15,13 +14,30 @@
 #define REFLECT(PROPERTY) \
         info.properties.push_back(make_property(#PROPERTY, &SelfType::PROPERTY)); 
 
+#define REFLECT_ACCESSOR(NAME, GETTER, SETTER) \
+        info.properties.push_back(make_accessor_property<SelfType>(#NAME, &SelfType::GETTER, &SelfType::SETTER));
+
 #define END_REFLECTION }
 
+// NOTE: The reflection data doesn't know anything about ImGui, so the physics code can be built without it. Whatever wants to
+// show the properties implements this (see ImGuiPropertyDrawer) and gets handed each value in turn.
+class PropertyDrawer {
+    public:
+    virtual ~PropertyDrawer() = default;
+
+    // Each of these returns true if the value was edited. The instance is only there to tell properties of different objects apart.
+    virtual bool Draw(const char* name, Vec2& value, const void* instance) = 0;
+    virtual bool Draw(const char* name, float& value, const void* instance) = 0;
+    virtual bool Draw(const char* name, bool& value, const void* instance) = 0;
+    virtual bool Draw(const char* name, const char* value, const void* instance) = 0;
+};
+
 template <typename Class>
 class IProperty{
     public:
     const char* name;
-    virtual void Draw(Class* instance) = 0;
+    // Returns true if the value was edited.
+    virtual bool Draw(Class* instance, PropertyDrawer& drawer) = 0;
     virtual ~IProperty() = default;
 };
 
@@ -34,36 +50,29 @@ class Property : public IProperty<Class> {
        this->name = _name;
     }
 
-    void Draw(Class* instance) override {
-        DrawImpl(instance->*member, instance);
+    bool Draw(Class* instance, PropertyDrawer& drawer) override {
+        return drawer.Draw(this->name, instance->*member, instance);
     }
+};
 
-    private:
-    
-    std::string ImGUIDHelper(Class* instance) {
-        return "##" + std::string(this->name) + "_" + std::to_string(reinterpret_cast<uintptr_t>(instance));
+// For values that aren't stored in the class itself (e.g. anything in the BodyStore), so they have to go through a getter and setter.
+template <typename Class, typename T>
+class AccessorProperty : public IProperty<Class> {
+    public:
+    T (Class::* getter)() const;
+    void (Class::* setter)(T);
 
+    AccessorProperty(const char* _name, T (Class::* get)() const, void (Class::* set)(T)) : getter(get), setter(set) {
+       this->name = _name;
     }
 
-    void DrawImpl(Vec2& vec2, Class* instance) {
-        ImGui::TableNextRow();
-        ImGui::TableNextColumn(); ImGui::Text(this->name);
-        ImGui::TableNextColumn(); ImGui::InputFloat2(ImGUIDHelper(instance).c_str(), &vec2.x);
-    }
-    
-    void DrawImpl(float& flt, Class* instance) {
-        ImGui::TableNextRow();
-        ImGui::TableNextColumn(); ImGui::Text(this->name);
-        ImGui::TableNextColumn(); ImGui::InputFloat(ImGUIDHelper(instance).c_str(), &flt);
-        if (flt < 0.01f) flt = 0.01f;
-    }
+    bool Draw(Class* instance, PropertyDrawer& drawer) override {
+        T value = (instance->*getter)();
+        if (!drawer.Draw(this->name, value, instance)) return false;
 
-    void DrawImpl(const char* string, Class* instance) {
-        ImGui::TableNextRow();
-        ImGui::TableNextColumn(); ImGui::Text(this->name);
-        ImGui::TableNextColumn(); ImGui::Text(string);
+        (instance->*setter)(value);
+        return true;
     }
-
 };
 
 // CTAD deduction guide for property constructor
@@ -76,6 +85,11 @@ std::unique_ptr<IProperty<Class>> make_property(const char* name, T Class::* m)
     return std::make_unique<Property<Class, T>>(name, m);
 }
 
+template<typename Class, typename Base, typename T>
+std::unique_ptr<IProperty<Class>> make_accessor_property(const char* name, T (Base::* get)() const, void (Base::* set)(T)) {
+    return std::make_unique<AccessorProperty<Class, T>>(name, get, set);
+}
+
 template<typename Class>
 struct TypeInfo{
     const char* name;
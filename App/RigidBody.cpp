@@ -3,83 +3,37 @@
 #include "Vec2.h"
 
 
-RigidBody::RigidBody(const ShapeType shapeID, const Vec2 position, const Vec2 velocity, const float orientation, const float mass, const Colour colour) : PhysicsObject(shapeID), m_orientation(orientation), m_colour(colour), m_position(position), m_velocity(velocity), m_mass(mass)
+RigidBody::RigidBody(const ShapeType shapeID, const Vec2 position, const Vec2 velocity, const float orientation, const float mass, const Colour colour) : PhysicsObject(shapeID, position, velocity, orientation, 1.0f / mass, 0.0f), m_colour(colour), m_mass(mass)
 {
-	m_invMass = 1.0f / mass;
-
-	// Change this later
-	m_torqueAccumulated = 0.0f;
-	m_angularVelocity = 0.0f;
+	// NOTE: The moment depends on the shape, so the derived class fills it in.
+	m_moment = 0.0f;
 }
 
 void RigidBody::ApplyForce(const Vec2 force)
 {
-	m_forceAccumulated += force;
+	const int index = GetBodyIndex();
+	bodies->forceX[index] += force.x;
+	bodies->forceY[index] += force.y;
 }
 
 void RigidBody::ApplyForceAtPoint(const Vec2 force, const Vec2 pos) {
 
-    m_forceAccumulated += force;
+    ApplyForce(force);
 
     // Arm length
-    Vec2 r = pos - m_position;
+    Vec2 r = pos - GetPosition();
 
     // Add torque
-    m_torqueAccumulated += PseudoCross(r, force);
+    bodies->torque[GetBodyIndex()] += PseudoCross(r, force);
 
 }
 void RigidBody::ResetPosition()
 {
-	m_position = { 0,0 };
-}
-
-Vec2 RigidBody::ResolveForces()
-{
-	const Vec2 acceleration = m_forceAccumulated * m_invMass;
-	m_forceAccumulated = { 0, 0 };
-	return acceleration;
+	SetPosition({ 0,0 });
 }
 
-void RigidBody::ApplyImpulse(const Vec2 impulse) //This is assumed to be through the centre of mass, so won't impart torque
+void RigidBody::SetMoment(const float moment)
 {
-	m_velocity += impulse * m_invMass;
-}
-
-void RigidBody::IntegrateForces(Vec2 gravity, float timeStep)
-{
-
-	// Apply gravity
-	ApplyForce(gravity * m_mass);
-
-    // Linear
-	const Vec2 acceleration = ResolveForces();
-	m_velocity += acceleration * timeStep;
-
-    // Rotational
-    const float angularAcceleration = ResolveAngular();
-    m_angularVelocity += angularAcceleration * timeStep;
-	m_angularVelocity *= 0.99f;
-
-
-}
-
-void RigidBody::IntegrateVelocity(float timeStep)
-{
-	m_position += m_velocity * timeStep;
-    m_orientation += m_angularVelocity * timeStep;
-}
-
-void RigidBody::ApplyImpulse(const Vec2 impulse, const Vec2 contactpoint)
-{
-	m_velocity += impulse * m_invMass;
-
-	Vec2 relativePos = contactpoint - this->m_position;
-	float leverArmLength = Dot(relativePos, impulse.GetNormalised().GetRotatedBy270());
-	m_angularVelocity += impulse.GetMagnitude() * leverArmLength * m_invMoment;
-}
-
-float RigidBody::ResolveAngular() {
-	const float angularAcceleration = m_torqueAccumulated * m_invMoment;
-    m_torqueAccumulated = 0;
-    return angularAcceleration;
+	m_moment = moment;
+	bodies->invMoment[GetBodyIndex()] = 1 / m_moment;
 }
@@ -4,7 +4,7 @@
 #include "Circle.h"
 #include "Box.h"
 #include <iostream>
-#include "PhysicsScene.h"
+#include "PhysicsWorld.h"
 
 json Serialiser::Save(const std::vector<PhysicsObject*>& actors) {
 
@@ -32,7 +32,8 @@ json Serialiser::Save(const std::vector<PhysicsObject*>& actors) {
                             {"velocityy", circle->GetVelocity().y},
                             {"mass", circle->GetMass()},
                             {"orientation", circle->GetOrientation()},
-                            {"radius", circle->GetRadius()}
+                            {"radius", circle->GetRadius()},
+                            {"speculative", circle->GetSpeculative()}
                         });
             }
             break;
@@ -49,6 +50,7 @@ json Serialiser::Save(const std::vector<PhysicsObject*>& actors) {
                             {"orientation", box->GetOrientation()},
                             {"halfwidth", box->GetHalfWidth()},
                             {"halfheight", box->GetHalfHeight()},
+                            {"speculative", box->GetSpeculative()},
                     });
             }
             break;
@@ -60,35 +62,37 @@ json Serialiser::Save(const std::vector<PhysicsObject*>& actors) {
     return output;
 }
 
-void Serialiser::Load(PhysicsScene* sceneref, void* data)
+void Serialiser::Load(PhysicsWorld* world, const char* data)
 {
-    char* dataconv = (char*)(data);
-    json jsonconv = json::parse(dataconv);
+    json jsonconv = json::parse(data);
     
 
     // Add every box
-    sceneref->ClearAllActor();
+    world->ClearAllActors();
 
+    // NOTE: Older saves don't have "speculative", so it's optional.
     for (auto& thisBox : jsonconv["Actors"]["Box"]) {
-        sceneref->AddActor(new Box(Vec2{ thisBox["positionx"], thisBox["positiony"] },
+        Box* box = new Box(Vec2{ thisBox["positionx"], thisBox["positiony"] },
             Vec2{ thisBox["velocityx"], thisBox["velocityy"] },
             thisBox["mass"],
             thisBox["halfwidth"],
             thisBox["halfheight"],
             thisBox["orientation"],
-            Colour::RED));
+            Colour::RED);
+        box->SetSpeculative(thisBox.value("speculative", false));
+        world->AddActor(box);
     }
 
     for (auto& thisCirc : jsonconv["Actors"]["Circle"]) {
-        sceneref->AddActor(new Circle(Vec2{ thisCirc["positionx"], thisCirc["positiony"] }, Vec2{ thisCirc["velocityx"], thisCirc["velocityy"] }, thisCirc["mass"],
-            thisCirc["radius"], thisCirc["orientation"], Colour::RED));
+        Circle* circle = new Circle(Vec2{ thisCirc["positionx"], thisCirc["positiony"] }, Vec2{ thisCirc["velocityx"], thisCirc["velocityy"] }, thisCirc["mass"],
+            thisCirc["radius"], thisCirc["orientation"], Colour::RED);
+        circle->SetSpeculative(thisCirc.value("speculative", false));
+        world->AddActor(circle);
     }
 
     for (auto& thisPlane : jsonconv["Actors"]["Planes"]) {
-        sceneref->AddActor(new Plane(Vec2{ thisPlane["normalx"], thisPlane["normaly"] }, thisPlane["origindistance"]));
+        world->AddActor(new Plane(Vec2{ thisPlane["normalx"], thisPlane["normaly"] }, thisPlane["origindistance"]));
     }
-
-    delete dataconv;
 }
 
 
@@ -6,7 +6,7 @@
 
 using json = nlohmann::json;
 
-class PhysicsScene;
+class PhysicsWorld;
 
 class Serialiser {
 public:
@@ -16,7 +16,7 @@ public:
 //
 json Save(const std::vector<PhysicsObject*>& actors);
 
-void Load(PhysicsScene* sceneref, void* data);
+void Load(PhysicsWorld* world, const char* data);
 };
 
 
@@ -0,0 +1,79 @@
+#include "SimulationThread.h"
+#include "PhysicsWorld.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+// If the simulation falls more than this many steps behind, it gives up on catching up, rather than spiralling.
+constexpr int MaxStepsBehind = 8;
+
+static double SecondsNow()
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+SimulationThread::SimulationThread(PhysicsWorld& world, float timeStep) : m_world(world), m_timeStep(timeStep)
+{
+}
+
+SimulationThread::~SimulationThread()
+{
+	Stop();
+}
+
+void SimulationThread::Start()
+{
+	if (IsRunning()) return;
+
+	m_running.store(true, std::memory_order_release);
+	m_thread = std::thread(&SimulationThread::Run, this);
+}
+
+void SimulationThread::Stop()
+{
+	if (!IsRunning()) return;
+
+	m_running.store(false, std::memory_order_release);
+	m_thread.join();
+}
+
+void SimulationThread::UpdateSnapshots()
+{
+	if (!m_buffer.HasNew()) return;
+
+	// NOTE: Swapping hands our old previous snapshot back to the simulation thread, which is fine since it clears it out anyway.
+	std::swap(m_previous, m_buffer.GetReadBuffer());
+	m_buffer.Acquire();
+}
+
+float SimulationThread::GetAlpha() const
+{
+	const double sinceCurrent = SecondsNow() - GetCurrent().time;
+	return std::clamp(static_cast<float>(sinceCurrent / m_timeStep), 0.0f, 1.0f);
+}
+
+void SimulationThread::Run()
+{
+	Profiler::SetThreadName("Simulation");
+
+	using Clock = std::chrono::steady_clock;
+	const Clock::duration stepLength = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(m_timeStep));
+	Clock::time_point nextStep = Clock::now();
+
+	while (m_running.load(std::memory_order_acquire)) {
+		{
+			PROFILE_ZONE("SimulationThread::Step");
+			std::lock_guard<std::mutex> lock(m_worldMutex);
+
+			if (m_stepping.load(std::memory_order_relaxed)) m_world.Simulate(m_timeStep);
+			m_buffer.GetWriteBuffer().Capture(m_world, std::chrono::duration<double>(nextStep.time_since_epoch()).count());
+		}
+		m_buffer.Publish();
+
+		nextStep += stepLength;
+		if (Clock::now() - nextStep > stepLength * MaxStepsBehind) nextStep = Clock::now();
+
+		std::this_thread::sleep_until(nextStep);
+	}
+}
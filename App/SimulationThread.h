@@ -0,0 +1,54 @@
+#pragma once
+#include "TripleBuffer.h"
+#include "WorldSnapshot.h"
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+class PhysicsWorld;
+
+// Steps a PhysicsWorld at a fixed rate on its own thread, so a slow frame on the main thread can't hold the physics up (and a slow
+// step can't hold up the frame). After every step it publishes a snapshot of every actor, and the main thread draws by blending
+// between the last two snapshots it has.
+//
+// NOTE: Anything else touching the world has to hold LockWorld() while it does. The simulation thread only holds it while it's
+// stepping, so editing things from the UI still works, it just makes the next step wait a bit.
+class SimulationThread {
+public:
+    SimulationThread(PhysicsWorld& world, float timeStep);
+    ~SimulationThread();
+    SimulationThread(const SimulationThread& other) = delete;
+    SimulationThread& operator=(const SimulationThread& other) = delete;
+
+    void Start();
+    void Stop();
+    [[nodiscard]] bool IsRunning() const { return m_thread.joinable(); }
+
+    // While false the world doesn't get stepped, but snapshots keep coming so edits still show up.
+    void SetStepping(bool stepping) { m_stepping.store(stepping, std::memory_order_relaxed); }
+
+    [[nodiscard]] std::unique_lock<std::mutex> LockWorld() { return std::unique_lock<std::mutex>(m_worldMutex); }
+
+    // Main thread side. Picks up the newest snapshot, if there is one.
+    void UpdateSnapshots();
+    [[nodiscard]] const WorldSnapshot& GetPrevious() const { return m_previous; }
+    [[nodiscard]] const WorldSnapshot& GetCurrent() const { return m_buffer.GetReadBuffer(); }
+
+    // How far between the previous and current snapshots to draw. Drawing runs a step behind the simulation, so there is always
+    // a snapshot on either side.
+    [[nodiscard]] float GetAlpha() const;
+
+private:
+    void Run();
+
+    PhysicsWorld& m_world;
+    float m_timeStep;
+
+    std::thread m_thread;
+    std::mutex m_worldMutex;
+    std::atomic<bool> m_running = false;
+    std::atomic<bool> m_stepping = false;
+
+    TripleBuffer<WorldSnapshot> m_buffer;
+    WorldSnapshot m_previous;
+};
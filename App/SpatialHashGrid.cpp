@@ -0,0 +1,189 @@
+#include "SpatialHashGrid.h"
+#include "PhysicsObject.h"
+#include <algorithm>
+
+// NOTE: Every 64-bit key is a valid cell (the key for (-1, -1) is all ones), so empty slots are marked by their count instead.
+constexpr int EmptySlot = -1;
+
+// Bodies up to this many times the median size still go in the grid. The cell size is picked so that two of these can't
+// overlap without being in neighbouring cells.
+constexpr float MaxRadiusRatio = 1.5f;
+
+// Stops the cells getting silly small if someone spawns a pile of tiny objects.
+constexpr float MinCellSize = 0.01f;
+
+static uint64_t CellKey(int cellX, int cellY)
+{
+	return (static_cast<uint64_t>(static_cast<uint32_t>(cellX)) << 32) | static_cast<uint32_t>(cellY);
+}
+
+static uint64_t HashKey(uint64_t key)
+{
+	// Finaliser from MurmurHash3. Neighbouring cells have very similar keys, so they need a good mix to spread them out.
+	key ^= key >> 33;
+	key *= 0xff51afd7ed558ccdULL;
+	key ^= key >> 33;
+	key *= 0xc4ceb9fe1a85ec53ULL;
+	key ^= key >> 33;
+	return key;
+}
+
+static float GetRadius(const AABB& aabb)
+{
+	const Vec2 extents = aabb.GetExtents();
+	return Max(extents.x, extents.y);
+}
+
+void SpatialHashGrid::FindPairs(float, std::vector<BroadPhasePair>& pairs)
+{
+	if (m_bodies.empty()) return;
+
+	ChooseCellSize();
+	BuildCells();
+
+	// Only visit half of the neighbours, so each pair of cells is only tested once.
+	constexpr int neighbourOffsets[4][2] = { { 1, 0 }, { -1, 1 }, { 0, 1 }, { 1, 1 } };
+
+	for (const int slot : m_occupiedCells) {
+		const GridCell& cell = m_cells[slot];
+		const int cellX = static_cast<int>(static_cast<uint32_t>(cell.key >> 32));
+		const int cellY = static_cast<int>(static_cast<uint32_t>(cell.key & 0xFFFFFFFF));
+
+		TestCell(cell, pairs);
+
+		for (const auto& offset : neighbourOffsets) {
+			const int neighbour = FindCell(cellX + offset[0], cellY + offset[1]);
+			if (neighbour != -1) TestCells(cell, m_cells[neighbour], pairs);
+		}
+	}
+
+	for (const int big : m_oversized) {
+		for (int other = 0; other < static_cast<int>(m_bodies.size()); other++) {
+			// Don't test two oversized bodies against each other twice.
+			if (other == big || (m_bodyCell[other] == -1 && other < big)) continue;
+			TestPair(big, other, pairs);
+		}
+	}
+}
+
+void SpatialHashGrid::ChooseCellSize()
+{
+	m_scratchRadii.resize(m_aabbs.size());
+	for (size_t i = 0; i < m_aabbs.size(); i++) {
+		m_scratchRadii[i] = GetRadius(m_aabbs[i]);
+	}
+
+	auto median = m_scratchRadii.begin() + m_scratchRadii.size() / 2;
+	std::nth_element(m_scratchRadii.begin(), median, m_scratchRadii.end());
+
+	m_cellSize = Max(2.0f * MaxRadiusRatio * *median, MinCellSize);
+}
+
+void SpatialHashGrid::BuildCells()
+{
+	const size_t bodyCount = m_bodies.size();
+
+	// Empty out last step's cells. Only touching the occupied ones keeps this proportional to the body count.
+	for (const int slot : m_occupiedCells) {
+		m_cells[slot].count = EmptySlot;
+	}
+	m_occupiedCells.clear();
+
+	// Keep the table at most half full so probe sequences stay short.
+	size_t capacity = 64;
+	while (capacity < 2 * bodyCount) capacity <<= 1;
+	if (m_cells.size() != capacity) {
+		m_cells.assign(capacity, { 0, 0, EmptySlot });
+	}
+
+	m_bodyCell.resize(bodyCount);
+	m_oversized.clear();
+
+	// Counting sort: first count how many bodies are in each cell...
+	const float maxRadius = 0.5f * m_cellSize;
+	for (size_t i = 0; i < bodyCount; i++) {
+		const AABB& aabb = m_aabbs[i];
+
+		if (GetRadius(aabb) > maxRadius) {
+			m_bodyCell[i] = -1;
+			m_oversized.push_back(static_cast<int>(i));
+			continue;
+		}
+
+		const Vec2 centre = aabb.GetCentre();
+		const int slot = FindOrInsertCell(static_cast<int>(floorf(centre.x / m_cellSize)), static_cast<int>(floorf(centre.y / m_cellSize)));
+		m_cells[slot].count++;
+		m_bodyCell[i] = slot;
+	}
+
+	// ...then give each cell its own range...
+	int start = 0;
+	for (const int slot : m_occupiedCells) {
+		m_cells[slot].start = start;
+		start += m_cells[slot].count;
+		m_cells[slot].count = 0;
+	}
+
+	// ...and drop the bodies into their ranges.
+	m_cellBodies.resize(start);
+	for (size_t i = 0; i < bodyCount; i++) {
+		if (m_bodyCell[i] == -1) continue;
+
+		GridCell& cell = m_cells[m_bodyCell[i]];
+		m_cellBodies[cell.start + cell.count++] = static_cast<int>(i);
+	}
+}
+
+int SpatialHashGrid::FindCell(int cellX, int cellY) const
+{
+	const uint64_t key = CellKey(cellX, cellY);
+	const size_t mask = m_cells.size() - 1;
+
+	for (size_t slot = HashKey(key) & mask; ; slot = (slot + 1) & mask) {
+		if (m_cells[slot].count == EmptySlot) return -1;
+		if (m_cells[slot].key == key) return static_cast<int>(slot);
+	}
+}
+
+int SpatialHashGrid::FindOrInsertCell(int cellX, int cellY)
+{
+	const uint64_t key = CellKey(cellX, cellY);
+	const size_t mask = m_cells.size() - 1;
+
+	for (size_t slot = HashKey(key) & mask; ; slot = (slot + 1) & mask) {
+		if (m_cells[slot].count == EmptySlot) {
+			m_cells[slot] = { key, 0, 0 };
+			m_occupiedCells.push_back(static_cast<int>(slot));
+			return static_cast<int>(slot);
+		}
+
+		if (m_cells[slot].key == key) return static_cast<int>(slot);
+	}
+}
+
+void SpatialHashGrid::TestCell(const GridCell& cell, std::vector<BroadPhasePair>& pairs) const
+{
+	for (int i = 0; i < cell.count; i++) {
+		for (int j = i + 1; j < cell.count; j++) {
+			TestPair(m_cellBodies[cell.start + i], m_cellBodies[cell.start + j], pairs);
+		}
+	}
+}
+
+void SpatialHashGrid::TestCells(const GridCell& a, const GridCell& b, std::vector<BroadPhasePair>& pairs) const
+{
+	for (int i = 0; i < a.count; i++) {
+		for (int j = 0; j < b.count; j++) {
+			TestPair(m_cellBodies[a.start + i], m_cellBodies[b.start + j], pairs);
+		}
+	}
+}
+
+void SpatialHashGrid::TestPair(int bodyA, int bodyB, std::vector<BroadPhasePair>& pairs) const
+{
+	if (!m_aabbs[bodyA].Overlaps(m_aabbs[bodyB])) return;
+
+	// Keep the same A/B order the old brute force loop had (the order the actors were added in).
+	if (bodyA < bodyB) pairs.push_back({ m_bodies[bodyA], m_bodies[bodyB] });
+	else pairs.push_back({ m_bodies[bodyB], m_bodies[bodyA] });
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include "BroadPhase.h"
+#include <cstdint>
+
+struct GridCell {
+	uint64_t key;
+
+	// Range of this cell's bodies in m_cellBodies. A count of -1 marks an empty slot in the table.
+	int start;
+	int count;
+};
+
+// Uniform grid broad phase, for scenes full of similarly sized objects (e.g. thousands of circles). Each body goes in the cell
+// containing its centre, and the cell size is picked so that overlapping bodies are always in the same or neighbouring cells.
+//
+// The cells live in a flat open-addressed hash table, so the grid is unbounded and only costs memory for occupied cells.
+// It is rebuilt from scratch every step, which is cheap since there's no tree to keep balanced.
+class SpatialHashGrid : public BroadPhase {
+public:
+	[[nodiscard]] float GetCellSize() const { return m_cellSize; }
+
+protected:
+	void AddProxy(PhysicsObject*) override {}
+	void RemoveProxy(PhysicsObject*) override {}
+	void ClearProxies() override {}
+	void FindPairs(float delta, std::vector<BroadPhasePair>& pairs) override;
+
+private:
+	void ChooseCellSize();
+	void BuildCells();
+
+	[[nodiscard]] int FindCell(int cellX, int cellY) const;
+	int FindOrInsertCell(int cellX, int cellY);
+
+	void TestCell(const GridCell& cell, std::vector<BroadPhasePair>& pairs) const;
+	void TestCells(const GridCell& a, const GridCell& b, std::vector<BroadPhasePair>& pairs) const;
+	void TestPair(int bodyA, int bodyB, std::vector<BroadPhasePair>& pairs) const;
+
+	float m_cellSize = 1.0f;
+
+	// Open-addressed (linear probing) table of cells. The size is always a power of two.
+	std::vector<GridCell> m_cells;
+	std::vector<int> m_occupiedCells;
+
+	// Body indices grouped by cell.
+	std::vector<int> m_cellBodies;
+
+	// Which cell each body is in, or -1 if it is too big for the grid.
+	std::vector<int> m_bodyCell;
+
+	// NOTE: Anything much bigger than the median would need to check more than the neighbouring cells, so those bodies are
+	// tested against everything instead. There should only be a handful of these in scenes where the grid makes sense.
+	std::vector<int> m_oversized;
+
+	std::vector<float> m_scratchRadii;
+};
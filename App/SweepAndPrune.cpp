@@ -0,0 +1,118 @@
+#include "SweepAndPrune.h"
+#include "PhysicsObject.h"
+#include <algorithm>
+
+// Above this many new bodies in a single step, a full sort beats insertion sort.
+constexpr int FullSortThreshold = 32;
+
+// The other axis has to be this much more spread out before we switch, so we don't flip-flop (and re-sort) every step.
+constexpr float AxisSwitchRatio = 1.5f;
+
+void SweepAndPrune::AddProxy(PhysicsObject* object)
+{
+	// NOTE: The base class has already added the object to m_bodies, so it's the last one.
+	const AABB aabb = object->GetAABB();
+	const int body = static_cast<int>(m_bodies.size()) - 1;
+
+	m_proxies.push_back({ m_axis == 0 ? aabb.min.x : aabb.min.y, m_axis == 0 ? aabb.max.x : aabb.max.y, body });
+
+	if (++m_addedSinceSort > FullSortThreshold) m_needsFullSort = true;
+}
+
+void SweepAndPrune::RemoveProxy(PhysicsObject* object)
+{
+	const int removed = static_cast<int>(std::find(m_bodies.begin(), m_bodies.end(), object) - m_bodies.begin());
+
+	// Everything after the removed body in m_bodies is about to shift down by one, so fix up the indices.
+	auto it = std::remove_if(m_proxies.begin(), m_proxies.end(), [removed](const SweepProxy& proxy) { return proxy.body == removed; });
+	m_proxies.erase(it, m_proxies.end());
+
+	for (SweepProxy& proxy : m_proxies) {
+		if (proxy.body > removed) proxy.body--;
+	}
+}
+
+void SweepAndPrune::ClearProxies()
+{
+	m_proxies.clear();
+	m_needsFullSort = false;
+	m_addedSinceSort = 0;
+}
+
+void SweepAndPrune::FindPairs(float, std::vector<BroadPhasePair>& pairs)
+{
+	ChooseAxis();
+
+	for (SweepProxy& proxy : m_proxies) {
+		const AABB& aabb = m_aabbs[proxy.body];
+		proxy.min = (m_axis == 0) ? aabb.min.x : aabb.min.y;
+		proxy.max = (m_axis == 0) ? aabb.max.x : aabb.max.y;
+	}
+
+	SortProxies();
+
+	// Sweep along the axis. Since the proxies are sorted by their minimum, once we reach one that starts after the current
+	// proxy ends, nothing further along can overlap it either.
+	for (size_t i = 0; i < m_proxies.size(); i++) {
+		const SweepProxy& a = m_proxies[i];
+
+		for (size_t j = i + 1; j < m_proxies.size() && m_proxies[j].min <= a.max; j++) {
+			const SweepProxy& b = m_proxies[j];
+
+			if (!m_aabbs[a.body].Overlaps(m_aabbs[b.body])) continue;
+
+			// Keep the same A/B order the old brute force loop had (the order the actors were added in).
+			if (a.body < b.body) pairs.push_back({ m_bodies[a.body], m_bodies[b.body] });
+			else pairs.push_back({ m_bodies[b.body], m_bodies[a.body] });
+		}
+	}
+}
+
+void SweepAndPrune::ChooseAxis()
+{
+	if (m_aabbs.empty()) return;
+
+	Vec2 sum;
+	Vec2 sumSquared;
+	for (const AABB& aabb : m_aabbs) {
+		const Vec2 centre = aabb.GetCentre();
+		sum += centre;
+		sumSquared += Vec2(centre.x * centre.x, centre.y * centre.y);
+	}
+
+	const float count = static_cast<float>(m_aabbs.size());
+	const float varianceX = sumSquared.x / count - (sum.x / count) * (sum.x / count);
+	const float varianceY = sumSquared.y / count - (sum.y / count) * (sum.y / count);
+
+	const float current = (m_axis == 0) ? varianceX : varianceY;
+	const float other = (m_axis == 0) ? varianceY : varianceX;
+
+	if (other > current * AxisSwitchRatio) {
+		m_axis = 1 - m_axis;
+		m_needsFullSort = true;
+	}
+}
+
+void SweepAndPrune::SortProxies()
+{
+	auto lessThan = [](const SweepProxy& a, const SweepProxy& b) { return a.min < b.min; };
+
+	if (m_needsFullSort) {
+		std::stable_sort(m_proxies.begin(), m_proxies.end(), lessThan);
+	}
+	else {
+		// Insertion sort. Bodies only move a tiny bit each step, so almost every proxy is already in the right spot.
+		for (size_t i = 1; i < m_proxies.size(); i++) {
+			const SweepProxy key = m_proxies[i];
+			size_t j = i;
+			while (j > 0 && lessThan(key, m_proxies[j - 1])) {
+				m_proxies[j] = m_proxies[j - 1];
+				j--;
+			}
+			m_proxies[j] = key;
+		}
+	}
+
+	m_needsFullSort = false;
+	m_addedSinceSort = 0;
+}
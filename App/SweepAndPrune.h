@@ -0,0 +1,35 @@
+#pragma once
+#include "BroadPhase.h"
+
+struct SweepProxy {
+	// Interval on the current sort axis.
+	float min;
+	float max;
+
+	// Index into m_bodies (and m_aabbs).
+	int body;
+};
+
+// Sort-and-sweep broad phase. The body intervals along one axis are kept sorted between steps, so when things barely move
+// (stacks, piles, etc.) re-sorting with insertion sort is close to linear.
+class SweepAndPrune : public BroadPhase {
+protected:
+	void AddProxy(PhysicsObject* object) override;
+	void RemoveProxy(PhysicsObject* object) override;
+	void ClearProxies() override;
+	void FindPairs(float delta, std::vector<BroadPhasePair>& pairs) override;
+
+private:
+	void ChooseAxis();
+	void SortProxies();
+
+	std::vector<SweepProxy> m_proxies;
+
+	// 0 for x, 1 for y. Whichever axis the bodies are most spread out along gives the fewest false positives.
+	int m_axis = 0;
+
+	// NOTE: Insertion sort is only fast when the list is already nearly sorted. If lots of bodies were just added (e.g. loading
+	// a scene) or the axis changed, we do a full sort instead.
+	bool m_needsFullSort = false;
+	int m_addedSinceSort = 0;
+};
@@ -0,0 +1,97 @@
+#include "TreeBroadPhase.h"
+#include "PhysicsObject.h"
+#include <algorithm>
+
+void TreeBroadPhase::AddProxy(PhysicsObject* object)
+{
+	object->m_proxyID = m_tree.CreateProxy(object->GetAABB(), object);
+	m_moveBuffer.push_back(object->m_proxyID);
+}
+
+void TreeBroadPhase::RemoveProxy(PhysicsObject* object)
+{
+	const int proxyID = object->m_proxyID;
+
+	m_moveBuffer.erase(std::remove(m_moveBuffer.begin(), m_moveBuffer.end(), proxyID), m_moveBuffer.end());
+
+	// Proxy IDs get recycled, so any cached pairs using this one have to go now.
+	auto it = std::remove_if(m_pairCache.begin(), m_pairCache.end(), [this, proxyID](uint64_t key) {
+		if (static_cast<int>(key >> 32) == proxyID || static_cast<int>(key & 0xFFFFFFFF) == proxyID) {
+			m_pairSet.erase(key);
+			return true;
+		}
+		return false;
+		});
+	m_pairCache.erase(it, m_pairCache.end());
+
+	m_tree.DestroyProxy(proxyID);
+	object->m_proxyID = NullNode;
+}
+
+void TreeBroadPhase::ClearProxies()
+{
+	for (PhysicsObject* body : m_bodies) {
+		body->m_proxyID = NullNode;
+	}
+
+	m_tree.Clear();
+	m_moveBuffer.clear();
+	m_pairCache.clear();
+	m_pairSet.clear();
+}
+
+void TreeBroadPhase::FindPairs(float delta, std::vector<BroadPhasePair>& pairs)
+{
+	// Refit every proxy. Most objects will still be inside their fattened bounds, so this is usually a no-op.
+	for (size_t i = 0; i < m_bodies.size(); i++) {
+		PhysicsObject* body = m_bodies[i];
+		if (m_tree.MoveProxy(body->m_proxyID, m_aabbs[i], body->GetVelocity() * delta)) {
+			m_moveBuffer.push_back(body->m_proxyID);
+		}
+	}
+
+	// Only proxies that moved can have gained new overlaps.
+	for (const int proxyID : m_moveBuffer) {
+		m_tree.Query(m_tree.GetFatAABB(proxyID), [this, proxyID](int otherID) {
+			if (otherID == proxyID) return true;
+
+			const uint64_t key = PairKey(proxyID, otherID);
+			if (m_pairSet.insert(key).second) {
+				m_pairCache.push_back(key);
+			}
+			return true;
+			});
+	}
+	m_moveBuffer.clear();
+
+	// Drop cached pairs whose fattened bounds have separated, and hand the rest on to the narrow phase.
+	size_t kept = 0;
+	for (const uint64_t key : m_pairCache) {
+		const int proxyA = static_cast<int>(key >> 32);
+		const int proxyB = static_cast<int>(key & 0xFFFFFFFF);
+
+		if (!m_tree.GetFatAABB(proxyA).Overlaps(m_tree.GetFatAABB(proxyB))) {
+			m_pairSet.erase(key);
+			continue;
+		}
+
+		m_pairCache[kept++] = key;
+		pairs.push_back({ m_tree.GetObject(proxyA), m_tree.GetObject(proxyB) });
+	}
+	m_pairCache.resize(kept);
+}
+
+void TreeBroadPhase::QueryBodies(const AABB& aabb, std::vector<PhysicsObject*>& results) const
+{
+	m_tree.Query(aabb, [this, &results](int proxyID) {
+		results.push_back(m_tree.GetObject(proxyID));
+		return true;
+		});
+}
+
+uint64_t TreeBroadPhase::PairKey(int proxyA, int proxyB)
+{
+	const uint64_t low = static_cast<uint64_t>(Min(proxyA, proxyB));
+	const uint64_t high = static_cast<uint64_t>(Max(proxyA, proxyB));
+	return (low << 32) | high;
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include "BroadPhase.h"
+#include "DynamicTree.h"
+#include <cstdint>
+#include <unordered_set>
+
+// Broad phase backed by a dynamic AABB tree. Overlapping pairs are cached between steps, so only proxies whose fattened bounds
+// changed need to query the tree for new pairs.
+class TreeBroadPhase : public BroadPhase {
+protected:
+	void AddProxy(PhysicsObject* object) override;
+	void RemoveProxy(PhysicsObject* object) override;
+	void ClearProxies() override;
+	void FindPairs(float delta, std::vector<BroadPhasePair>& pairs) override;
+	void QueryBodies(const AABB& aabb, std::vector<PhysicsObject*>& results) const override;
+
+private:
+	static uint64_t PairKey(int proxyA, int proxyB);
+
+	DynamicTree m_tree;
+
+	// Proxies that were created or whose fat AABB changed since the last step.
+	std::vector<int> m_moveBuffer;
+
+	// NOTE: The vector keeps the pairs in a stable order (so the solver sees them in the same order every run), and the set
+	// is just for fast lookups.
+	std::vector<uint64_t> m_pairCache;
+	std::unordered_set<uint64_t> m_pairSet;
+};
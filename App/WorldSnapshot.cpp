@@ -0,0 +1,84 @@
+#include "WorldSnapshot.h"
+#include "Box.h"
+#include "Circle.h"
+#include "ContactConstraint.h"
+#include "Plane.h"
+#include "PhysicsWorld.h"
+
+ActorSnapshot ActorSnapshot::FromActor(const PhysicsObject* actor)
+{
+	ActorSnapshot snapshot;
+	snapshot.shape = actor->m_ShapeID;
+
+	switch (actor->m_ShapeID) {
+	case ShapeType::BOX: {
+		const Box* box = static_cast<const Box*>(actor);
+		snapshot.colour = box->GetColour();
+		snapshot.position = box->GetPosition();
+		snapshot.orientation = box->GetOrientation();
+		snapshot.halfExtents = { box->GetHalfWidth(), box->GetHalfHeight() };
+	}
+	break;
+
+	case ShapeType::CIRCLE: {
+		const Circle* circle = static_cast<const Circle*>(actor);
+		snapshot.colour = circle->GetColour();
+		snapshot.position = circle->GetPosition();
+		snapshot.orientation = circle->GetOrientation();
+		snapshot.radius = circle->GetRadius();
+	}
+	break;
+
+	case ShapeType::PLANE: {
+		const Plane* plane = static_cast<const Plane*>(actor);
+		snapshot.normal = plane->GetNormal();
+		snapshot.distance = plane->GetDistance();
+	}
+	break;
+
+	default:
+		break;
+	}
+
+	return snapshot;
+}
+
+ActorSnapshot ActorSnapshot::FromActor(const PhysicsObject* actor, float alpha)
+{
+	const ActorSnapshot current = FromActor(actor);
+
+	ActorSnapshot previous = current;
+	previous.position = actor->GetPreviousPosition();
+	previous.orientation = actor->GetPreviousOrientation();
+
+	return Interpolate(previous, current, alpha);
+}
+
+ActorSnapshot ActorSnapshot::Interpolate(const ActorSnapshot& a, const ActorSnapshot& b, float t)
+{
+	ActorSnapshot result = b;
+	result.position = a.position + (b.position - a.position) * t;
+
+	// NOTE: Orientations aren't wrapped, so a straight lerp already goes the short way round.
+	result.orientation = a.orientation + (b.orientation - a.orientation) * t;
+	return result;
+}
+
+void WorldSnapshot::Capture(const PhysicsWorld& world, double captureTime)
+{
+	time = captureTime;
+	actorsVersion = world.GetActorsVersion();
+
+	// NOTE: Reuses the vectors' memory, since the same few snapshots get filled in over and over.
+	actors.clear();
+	for (const PhysicsObject* actor : world.GetActors()) {
+		actors.push_back(ActorSnapshot::FromActor(actor));
+	}
+
+	contactPoints.clear();
+	for (const ContactConstraint& contact : world.GetContacts()) {
+		for (int i = 0; i < contact.pointCount; i++) {
+			contactPoints.push_back(contact.points[i].collisionPoint);
+		}
+	}
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include "Colour.h"
+#include "PhysicsObject.h"
+#include <cstdint>
+#include <vector>
+
+class PhysicsWorld;
+
+// Everything needed to draw an actor, copied out of the world so it can be drawn without touching it.
+struct ActorSnapshot {
+    ShapeType shape = ShapeType::BOX;
+    Colour colour = Colour::WHITE;
+    Vec2 position = { 0.0f, 0.0f };
+    float orientation = 0.0f;
+
+    // Box
+    Vec2 halfExtents = { 0.0f, 0.0f };
+    // Circle
+    float radius = 0.0f;
+    // Plane
+    Vec2 normal = { 0.0f, 1.0f };
+    float distance = 0.0f;
+
+    static ActorSnapshot FromActor(const PhysicsObject* actor);
+    // Somewhere between where the actor was before the last step (0) and where it is now (1).
+    static ActorSnapshot FromActor(const PhysicsObject* actor, float alpha);
+
+    // Blends the pose between two snapshots of the same actor, and takes everything else from b.
+    static ActorSnapshot Interpolate(const ActorSnapshot& a, const ActorSnapshot& b, float t);
+};
+
+// The state of every actor after one step.
+struct WorldSnapshot {
+    // When the step was scheduled to happen, in seconds on the steady clock.
+    double time = 0.0;
+
+    // Changes whenever actors are added or removed, so snapshots with different actor lists don't get blended together.
+    uint64_t actorsVersion = 0;
+
+    std::vector<ActorSnapshot> actors;
+    std::vector<Vec2> contactPoints;
+
+    void Capture(const PhysicsWorld& world, double captureTime);
+};
@@ -0,0 +1,344 @@
+#include "PhysicsWorld.h"
+#include "Box.h"
+#include "Circle.h"
+#include "Plane.h"
+#include "Colour.h"
+#include "json.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using json = nlohmann::json;
+
+// Builds each of the canonical scenes at each size, steps it a fixed number of ticks and writes out how long every phase of the step
+// took (mean, median, 99th percentile and worst tick) as JSON.
+//
+// Usage: Bench [--scenes name,name,...] [--sizes N,N,...] [--ticks N] [--warmup N] [--dt seconds] [--threads N] [--out file]
+
+static void PrintUsage()
+{
+	std::cerr << "Usage: Bench [--scenes name,name,...] [--sizes N,N,...] [--ticks N] [--warmup N] [--dt seconds] [--threads N] [--out file]\n";
+	std::cerr << "Scenes: pyramid, rain, pile, sleeping, impacts\n";
+}
+
+// NOTE: Not using the <random> distributions, since they're allowed to give different numbers on different standard libraries, and
+// the scenes have to be the same everywhere for the numbers to be comparable.
+class SceneRandom {
+public:
+	float Range(float min, float max)
+	{
+		const float t = static_cast<float>(m_engine() >> 8) * (1.0f / 16777216.0f);
+		return min + (max - min) * t;
+	}
+
+private:
+	std::mt19937 m_engine{ 1234 };
+};
+
+static void AddGroundAndWalls(PhysicsWorld& world, float halfWidth)
+{
+	world.AddActor(new Plane({ 0.0f, 1.0f }, 0.0f));
+	world.AddActor(new Plane({ 1.0f, 0.0f }, -halfWidth));
+	world.AddActor(new Plane({ -1.0f, 0.0f }, -halfWidth));
+}
+
+// Boxes stacked into a triangle, with the base as wide as it needs to be to fit the body count.
+static void BuildPyramid(PhysicsWorld& world, int bodyCount)
+{
+	const float size = 1.0f;
+	const float gap = 0.05f;
+	const int base = static_cast<int>(std::ceil((std::sqrt(8.0f * bodyCount + 1.0f) - 1.0f) * 0.5f));
+
+	world.AddActor(new Plane({ 0.0f, 1.0f }, 0.0f));
+
+	int placed = 0;
+	for (int row = 0; row < base && placed < bodyCount; row++) {
+		const int rowCount = base - row;
+		const float left = -0.5f * (rowCount - 1) * (size + gap);
+		for (int i = 0; i < rowCount && placed < bodyCount; i++, placed++) {
+			const Vec2 position = { left + i * (size + gap), 0.5f * size + row * size };
+			world.AddActor(new Box(position, { 0.0f, 0.0f }, 1.0f, 0.5f * size, 0.5f * size, 0.0f, Colour::ORANGE));
+		}
+	}
+}
+
+// Circles dropped from a grid into a walled off area, with a bit of sideways velocity so they don't land in neat columns.
+static void BuildRain(PhysicsWorld& world, int bodyCount)
+{
+	SceneRandom random;
+	const int columns = std::max(1, static_cast<int>(std::sqrt(static_cast<float>(bodyCount))));
+	const float spacing = 1.5f;
+	const float halfWidth = 0.5f * columns * spacing + 1.0f;
+
+	AddGroundAndWalls(world, halfWidth);
+
+	for (int i = 0; i < bodyCount; i++) {
+		const Vec2 position = { -0.5f * (columns - 1) * spacing + (i % columns) * spacing, 2.0f + (i / columns) * spacing };
+		const Vec2 velocity = { random.Range(-2.0f, 2.0f), random.Range(-1.0f, 0.0f) };
+		world.AddActor(new Circle(position, velocity, 1.0f, random.Range(0.3f, 0.6f), 0.0f, Colour::CYAN));
+	}
+}
+
+// Boxes and circles of different sizes and masses, starting at random angles and falling into a heap.
+static void BuildPile(PhysicsWorld& world, int bodyCount)
+{
+	SceneRandom random;
+	const int columns = std::max(1, static_cast<int>(std::sqrt(static_cast<float>(bodyCount))));
+	const float spacing = 1.6f;
+	const float halfWidth = 0.5f * columns * spacing + 1.0f;
+
+	AddGroundAndWalls(world, halfWidth);
+
+	for (int i = 0; i < bodyCount; i++) {
+		const Vec2 position = { -0.5f * (columns - 1) * spacing + (i % columns) * spacing, 2.0f + (i / columns) * spacing };
+		const float mass = random.Range(0.5f, 4.0f);
+
+		if (i % 2 == 0) {
+			world.AddActor(new Box(position, { 0.0f, 0.0f }, mass, random.Range(0.25f, 0.7f), random.Range(0.25f, 0.7f), random.Range(0.0f, 3.14159f), Colour::YELLOW));
+		}
+		else {
+			world.AddActor(new Circle(position, { 0.0f, 0.0f }, mass, random.Range(0.25f, 0.7f), 0.0f, Colour::GREEN));
+		}
+	}
+}
+
+// A wide grid of boxes that aren't touching anything. There's no gravity, so they all fall asleep as soon as the sleep timer runs
+// out, and this ends up measuring what a big level full of sleeping props costs every step.
+static void BuildSleepingGrid(PhysicsWorld& world, int bodyCount)
+{
+	const int rows = std::max(1, static_cast<int>(std::sqrt(static_cast<float>(bodyCount) / 16.0f)));
+	const int columns = (bodyCount + rows - 1) / rows;
+	const float spacing = 1.5f;
+
+	world.settings.gravity = { 0.0f, 0.0f };
+	world.AddActor(new Plane({ 0.0f, 1.0f }, 0.0f));
+
+	for (int i = 0; i < bodyCount; i++) {
+		const Vec2 position = { -0.5f * (columns - 1) * spacing + (i % columns) * spacing, 1.0f + (i / columns) * spacing };
+		world.AddActor(new Box(position, { 0.0f, 0.0f }, 1.0f, 0.5f, 0.5f, 0.0f, Colour::GREY));
+	}
+}
+
+// A row of boxes that get left to fall asleep, then fast circles fired down at them from different heights, so they keep arriving
+// all the way through the run. Every hit comes from the continuous collision sweep waking up a sleeping box, after the islands for
+// that step have already been built.
+static void BuildImpacts(PhysicsWorld& world, int bodyCount)
+{
+	const int boxCount = std::max(1, bodyCount / 2);
+	const float spacing = 1.5f;
+	const float speed = 250.0f;
+
+	world.AddActor(new Plane({ 0.0f, 1.0f }, 0.0f));
+
+	for (int i = 0; i < boxCount; i++) {
+		const Vec2 position = { -0.5f * (boxCount - 1) * spacing + i * spacing, 0.5f };
+		world.AddActor(new Box(position, { 0.0f, 0.0f }, 1.0f, 0.5f, 0.5f, 0.0f, Colour::GREY));
+	}
+
+	// NOTE: Stepped here rather than in the warmup, so the boxes are asleep before any of the circles exist.
+	for (int tick = 0; tick < 600 && world.GetBodies().GetAwakeCount() > 0; tick++) {
+		world.Step(1.0f / 60.0f);
+	}
+
+	// The heights repeat every 60 columns, so even the biggest scenes have their circles land within about five seconds.
+	for (int i = boxCount; i < bodyCount; i++) {
+		const int column = i % boxCount;
+		const int layer = i / boxCount;
+		const float height = 5.0f + ((column * 7 + layer) % 60) * 20.0f;
+		const Vec2 position = { -0.5f * (boxCount - 1) * spacing + column * spacing, height };
+		world.AddActor(new Circle(position, { 0.0f, -speed }, 1.0f, 0.25f, 0.0f, Colour::RED));
+	}
+}
+
+struct BenchScene {
+	const char* name;
+	void (*build)(PhysicsWorld&, int);
+};
+
+static const BenchScene Scenes[] = {
+	{ "pyramid", BuildPyramid },
+	{ "rain", BuildRain },
+	{ "pile", BuildPile },
+	{ "sleeping", BuildSleepingGrid },
+	{ "impacts", BuildImpacts },
+};
+
+static const char* BroadPhaseName(BroadPhaseType type)
+{
+	switch (type) {
+	case BroadPhaseType::BRUTE_FORCE: return "bruteforce";
+	case BroadPhaseType::AABB_TREE: return "aabbtree";
+	case BroadPhaseType::SWEEP_AND_PRUNE: return "sweepandprune";
+	case BroadPhaseType::SPATIAL_HASH: return "spatialhash";
+	}
+	return "unknown";
+}
+
+static std::vector<std::string> SplitList(const char* list)
+{
+	std::vector<std::string> items;
+	std::string item;
+	for (const char* c = list; ; c++) {
+		if (*c == ',' || *c == '\0') {
+			if (!item.empty()) items.push_back(item);
+			item.clear();
+			if (*c == '\0') break;
+		}
+		else item += *c;
+	}
+	return items;
+}
+
+// Mean, median, 99th percentile and max of one phase over every timed tick.
+static json Summarise(std::vector<double>& samples)
+{
+	if (samples.empty()) return { { "mean", 0.0 }, { "p50", 0.0 }, { "p99", 0.0 }, { "max", 0.0 } };
+
+	std::sort(samples.begin(), samples.end());
+
+	double sum = 0.0;
+	for (const double sample : samples) sum += sample;
+
+	// Nearest rank, so p99 of fewer than 100 ticks is just the max.
+	const auto percentile = [&samples](double p) {
+		const size_t rank = static_cast<size_t>(std::ceil(p * samples.size()));
+		return samples[std::clamp<size_t>(rank, 1, samples.size()) - 1];
+	};
+
+	return {
+		{ "mean", sum / samples.size() },
+		{ "p50", percentile(0.5) },
+		{ "p99", percentile(0.99) },
+		{ "max", samples.back() },
+	};
+}
+
+int main(int argc, char** argv)
+{
+	std::vector<std::string> sceneNames;
+	std::vector<int> sizes = { 100, 1000, 10000 };
+	const char* outPath = nullptr;
+	int ticks = 300;
+	int warmup = 60;
+	float timeStep = 1.0f / 60.0f;
+	int threads = 0;
+
+	for (int i = 1; i < argc; i++) {
+		const bool hasValue = i + 1 < argc;
+
+		if (strcmp(argv[i], "--scenes") == 0 && hasValue) sceneNames = SplitList(argv[++i]);
+		else if (strcmp(argv[i], "--sizes") == 0 && hasValue) {
+			sizes.clear();
+			for (const std::string& size : SplitList(argv[++i])) sizes.push_back(atoi(size.c_str()));
+		}
+		else if (strcmp(argv[i], "--ticks") == 0 && hasValue) ticks = atoi(argv[++i]);
+		else if (strcmp(argv[i], "--warmup") == 0 && hasValue) warmup = atoi(argv[++i]);
+		else if (strcmp(argv[i], "--dt") == 0 && hasValue) timeStep = static_cast<float>(atof(argv[++i]));
+		else if (strcmp(argv[i], "--threads") == 0 && hasValue) threads = atoi(argv[++i]);
+		else if (strcmp(argv[i], "--out") == 0 && hasValue) outPath = argv[++i];
+		else {
+			PrintUsage();
+			return 1;
+		}
+	}
+
+	if (sceneNames.empty()) {
+		for (const BenchScene& scene : Scenes) sceneNames.push_back(scene.name);
+	}
+
+	const bool badSize = std::any_of(sizes.begin(), sizes.end(), [](int size) { return size <= 0; });
+	if (sizes.empty() || badSize || ticks <= 0 || warmup < 0 || timeStep <= 0.0f) {
+		PrintUsage();
+		return 1;
+	}
+
+	std::vector<const BenchScene*> selected;
+	for (const std::string& name : sceneNames) {
+		const auto found = std::find_if(std::begin(Scenes), std::end(Scenes), [&name](const BenchScene& scene) { return name == scene.name; });
+		if (found == std::end(Scenes)) {
+			std::cerr << "Unknown scene " << name << '\n';
+			PrintUsage();
+			return 1;
+		}
+		selected.push_back(found);
+	}
+
+	json output;
+	output["Bench"] = {
+		{ "ticks", ticks },
+		{ "warmup", warmup },
+		{ "timestep", timeStep },
+	};
+	output["Results"] = json::array();
+
+	for (const BenchScene* scene : selected) {
+		for (const int size : sizes) {
+			std::cerr << scene->name << " " << size << "...\n";
+
+			PhysicsWorld world(threads);
+			scene->build(world, size);
+
+			for (int tick = 0; tick < warmup; tick++) {
+				world.Step(timeStep);
+			}
+
+			std::vector<double> broadPhase, narrowPhase, constraintSetup, solve, integrate, continuous, sleep, total;
+			size_t contactCount = 0;
+
+			for (int tick = 0; tick < ticks; tick++) {
+				world.Step(timeStep);
+
+				const StepTimings& timings = world.GetTimings();
+				broadPhase.push_back(timings.broadPhase);
+				narrowPhase.push_back(timings.narrowPhase);
+				constraintSetup.push_back(timings.constraintSetup);
+				solve.push_back(timings.solve);
+				integrate.push_back(timings.integrate);
+				continuous.push_back(timings.continuous);
+				sleep.push_back(timings.sleep);
+				total.push_back(timings.total);
+				contactCount += world.GetContacts().size();
+			}
+
+			output["Results"].push_back({
+				{ "scene", scene->name },
+				{ "bodies", size },
+				{ "threads", world.GetThreadCount() },
+				{ "simd", world.GetSolver().GetSimd() },
+				{ "broadphasetype", BroadPhaseName(world.GetBroadPhaseType()) },
+				{ "meancontacts", static_cast<double>(contactCount) / ticks },
+				{ "awakebodies", world.GetBodies().GetAwakeCount() },
+				{ "broadphase", Summarise(broadPhase) },
+				{ "narrowphase", Summarise(narrowPhase) },
+				{ "constraintsetup", Summarise(constraintSetup) },
+				{ "solve", Summarise(solve) },
+				{ "integrate", Summarise(integrate) },
+				{ "continuous", Summarise(continuous) },
+				{ "sleep", Summarise(sleep) },
+				{ "step", Summarise(total) },
+			});
+		}
+	}
+
+	const std::string stringified = output.dump(3);
+
+	if (!outPath) {
+		std::cout << stringified << '\n';
+		return 0;
+	}
+
+	std::ofstream file(outPath);
+	if (!file.is_open()) {
+		std::cerr << "Failed to open " << outPath << '\n';
+		return 1;
+	}
+	file << stringified << '\n';
+
+	return 0;
+}
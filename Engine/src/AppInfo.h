@@ -36,6 +36,9 @@ struct AppInfo
 	float lineWidth = 3.0f;
 	Colour backgroundColour = Colour::BLACK;
 	unsigned int fixedFramerate = 120;
+	//If a frame takes long enough to need more fixed updates than this, the extra time is dropped and the simulation slows
+	//down instead of trying to catch up.
+	unsigned int maxFixedUpdatesPerFrame = 5;
 	CameraControls camera;
 	GridInfo grid;
 };
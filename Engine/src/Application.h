@@ -4,20 +4,41 @@
 enum class Key;
 enum class Button;
 class LineRenderer;
+class ShapeRenderer;
+class LineLayers;
 
 class Application
 {
 public:
 	virtual void Initialise() {}
+
+	//Called at the fixed framerate, as many times as it takes to keep up with real time, so keep it to just the simulation.
+	virtual void FixedUpdate(float delta) {}
+
+	//Called once a frame, with how long the frame took. UI and anything else that only needs doing once a frame goes here.
 	virtual void Update(float delta) = 0;
+
+	//Called once a frame, right before drawing, which may be more or less often than Update. alpha is how far the harness has
+	//got from the last fixed update towards the next one (0 to 1), for smoothing out anything that only moves in Update.
+	virtual void Render(float alpha) {}
 	virtual ~Application() = default;
 	bool leftMouseDown;
 	bool rightMouseDown;
 	Vec2 cursorPos;
 	LineRenderer* lines = nullptr;
+	//Cleared before every Render(), so only draw to this from there.
+	LineRenderer* frameLines = nullptr;
+	//Circles and boxes drawn on the GPU, one instance each. Also cleared before every Render().
+	ShapeRenderer* frameShapes = nullptr;
+	//Lines that are kept from one frame to the next, and only redrawn when marked dirty. The grid is one of these.
+	LineLayers* layers = nullptr;
 
 	float appTime = 0.0f;
 
+	//How much of the last frame's real time the fixed updates actually covered. Below 1 means they couldn't keep up and the
+	//simulation is running in slow motion.
+	float timeDilation = 1.0f;
+
 	virtual void OnLeftClick() {}
 	virtual void OnLeftRelease() {}
 	virtual void OnRightClick() {}
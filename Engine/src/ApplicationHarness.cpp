@@ -3,6 +3,7 @@
 #include "imgui_impl_sdl3.h"
 #include "imgui_impl_opengl3.h"
 #include "Maths.h"
+#include "Profiler.h"
 #include "Utilities.h"
 #include <SDL3/SDL_camera.h>
 #include <iostream>
@@ -53,6 +54,9 @@ ApplicationHarness::ApplicationHarness(Application* appInit) : app(appInit)
 	}
 
 	fixedFramerate = appInfo.fixedFramerate;
+	maxFixedUpdatesPerFrame = appInfo.maxFixedUpdatesPerFrame;
+
+	Profiler::SetThreadName("Main");
 
 	//This is where GLAD gets set up. After this point we can use openGL functions.
 	if (!gladLoadGL())
@@ -72,10 +76,15 @@ ApplicationHarness::ApplicationHarness(Application* appInit) : app(appInit)
 	ImGui::GetIO().FontGlobalScale = pixelDensityScale;
 
 	simpleShader = ShaderProgram("Shaders/Simple.vsd", "Shaders/Simple.fsd");
+	shapeShader = ShaderProgram("Shaders/Shape.vsd", "Shaders/Simple.fsd");
 	simpleShader.UseShader();
 
 	lines.Initialise();
 	app->lines = &lines;
+	frameLines.Initialise();
+	app->frameLines = &frameLines;
+	frameShapes.Initialise();
+	app->frameShapes = &frameShapes;
 
 	glClearColor(
 		appInfo.backgroundColour.r,
@@ -84,8 +93,11 @@ ApplicationHarness::ApplicationHarness(Application* appInit) : app(appInit)
 
 	glLineWidth(appInfo.lineWidth * pixelDensityScale);
 
-	grid.Initialise();
-	
+	app->layers = &layers;
+
+	//The grid never changes, so it's drawn once into a layer of its own.
+	LineRenderer& grid = layers.Get("Grid");
+	layers.BeginRebuild("Grid");
 	float gridPosExtreme = appInfo.grid.extent * appInfo.grid.unit;
 	float gridUnit = appInfo.grid.unit;
 	int gridExtent = (int)appInfo.grid.extent;
@@ -101,9 +113,8 @@ ApplicationHarness::ApplicationHarness(Application* appInit) : app(appInit)
 		grid.DrawLineSegment(Vec2(), Vec2(appInfo.grid.basisLineLength, 0), appInfo.grid.positiveXLineColour);
 		grid.DrawLineSegment(Vec2(), Vec2(0, appInfo.grid.basisLineLength), appInfo.grid.positiveYLineColour);
 	}
-	grid.Compile();
 
-	showGrid = appInfo.grid.show;
+	layers.SetVisible("Grid", appInfo.grid.show);
 
 	app->Initialise();
 }
@@ -135,21 +146,50 @@ void ApplicationHarness::Run()
 
 		accumulator += frameTime;
 
-		while (accumulator >= fixedDelta)
+		//If the fixed updates are slower than real time, trying to catch up just makes the next frame even longer (the 'spiral
+		//of death'). Past the cap the leftover time gets thrown away, so the simulation runs in slow motion instead.
+		double droppedTime = 0.0;
+		const double maxAccumulated = fixedDelta * maxFixedUpdatesPerFrame;
+		if (accumulator > maxAccumulated)
+		{
+			droppedTime = accumulator - maxAccumulated;
+			accumulator = maxAccumulated;
+		}
+		app->timeDilation = (frameTime > 0.0) ? (float)((frameTime - droppedTime) / frameTime) : 1.0f;
+
 		{
-			Update((float)fixedDelta);
-			accumulator -= fixedDelta;
+			//Every fixed update needed to catch up to real time shows up as its own FixedUpdate inside this.
+			PROFILE_ZONE("ApplicationHarness::FixedSteps");
+			while (accumulator >= fixedDelta)
+			{
+				FixedUpdate((float)fixedDelta);
+				accumulator -= fixedDelta;
+			}
 		}
 
+		//The UI and drawing only need doing once a frame, however many fixed updates it took.
+		Update((float)frameTime);
+
 		if (IsRunning())
 		{
-			Render();
+			Render((float)(accumulator / fixedDelta));
 		}
+
+		Profiler::EndFrame();
 	}
 }
 
+void ApplicationHarness::FixedUpdate(float delta)
+{
+	PROFILE_ZONE("ApplicationHarness::FixedUpdate");
+
+	app->FixedUpdate(delta);
+}
+
 void ApplicationHarness::Update(float delta)
 {
+	PROFILE_ZONE("ApplicationHarness::Update");
+
 	int width, height;
 	SDL_GetWindowSize(window, &width, &height);
 	aspectRatio = width / (float)height;
@@ -183,7 +223,11 @@ void ApplicationHarness::Update(float delta)
 	{
 		app->MoveCameraScaled(GetInputDirection(Key::W, Key::A, Key::S, Key::D) * delta * app->GetAppInfo().camera.cameraSpeed);
 	}
-	lines.UpdateWithCameraInfo(cameraCentre, cameraHeight, aspectRatio);
+	int pixelWidth, pixelHeight;
+	SDL_GetWindowSizeInPixels(window, &pixelWidth, &pixelHeight);
+	lines.UpdateWithCameraInfo(cameraCentre, cameraHeight, aspectRatio, pixelHeight);
+	frameLines.UpdateWithCameraInfo(cameraCentre, cameraHeight, aspectRatio, pixelHeight);
+	frameShapes.UpdateWithCameraInfo(cameraCentre, cameraHeight, aspectRatio, pixelHeight);
 
 	app->Update(delta);
 
@@ -202,14 +246,28 @@ void ApplicationHarness::Update(float delta)
 	}
 }
 
-void ApplicationHarness::Render()
+void ApplicationHarness::Render(float alpha)
 {
+	PROFILE_ZONE("ApplicationHarness::Render");
+
+	frameLines.Clear();
+	frameShapes.Clear();
+	app->Render(alpha);
+	frameLines.Compile();
+	frameShapes.Compile();
+
 	glClear(GL_COLOR_BUFFER_BIT);
 	float orthoMat[16];
 	PopulateCameraTransform(orthoMat);
+	simpleShader.UseShader();
 	simpleShader.SetMat4Uniform("vpMatrix", orthoMat);
-	if (showGrid) grid.Draw();
+	layers.Draw();
 	lines.Draw();
+	frameLines.Draw();
+
+	shapeShader.UseShader();
+	shapeShader.SetMat4Uniform("vpMatrix", orthoMat);
+	frameShapes.Draw(shapeShader);
 
 
 	//Render tends to get called once or twice before Update
@@ -2,6 +2,8 @@
 #include "Graphics.h"
 #include "Maths.h"
 #include "LineRenderer.h"
+#include "ShapeRenderer.h"
+#include "LineLayers.h"
 #include "ShaderProgram.h"
 #include "Application.h"
 #include "Key.h"
@@ -18,13 +20,16 @@ private:
 	Application* app = nullptr;
 
 	ShaderProgram simpleShader;
+	ShaderProgram shapeShader;
 	float aspectRatio;
 
-	LineRenderer grid;
+	LineLayers layers;
 	LineRenderer lines;
+	LineRenderer frameLines;
+	ShapeRenderer frameShapes;
 
 	unsigned int fixedFramerate;
-	bool showGrid;
+	unsigned int maxFixedUpdatesPerFrame;
 
 	bool tryingToClose = false;
 
@@ -40,8 +45,9 @@ public:
 	
 	void Run();
 
+	void FixedUpdate(float delta);
 	void Update(float delta);
-	void Render();
+	void Render(float alpha);
 
 	bool IsRunning() const;
 
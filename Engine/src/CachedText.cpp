@@ -0,0 +1,19 @@
+#include "CachedText.h"
+#include "LineRenderer.h"
+
+void CachedText::Set(std::string_view newText)
+{
+	if (newText == text) return;
+	text = newText;
+
+	points.clear();
+	width = 0.0f;
+	for (char character : text)
+	{
+		for (const GlyphPoint& point : LineRenderer::GetGlyph(character))
+		{
+			points.push_back({ point.x + width, point.y });
+		}
+		if (character == ' ' || !LineRenderer::GetGlyph(character).empty()) width += 1.0f;
+	}
+}
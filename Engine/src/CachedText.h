@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Glyphs.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+//A string that's been laid out ahead of time, for labels that stay the same from frame to frame. Set() only redoes the layout
+//when the text actually changes, so drawing one is just copying its points into the line renderer.
+class CachedText
+{
+private:
+	std::string text;
+	//Glyph segments for the whole string at size 1, starting from the origin.
+	std::vector<GlyphPoint> points;
+	float width = 0.0f;
+
+public:
+	CachedText() = default;
+	CachedText(std::string_view textInit) { Set(textInit); }
+
+	void Set(std::string_view newText);
+
+	const std::string& GetText() const { return text; }
+	const std::vector<GlyphPoint>& GetPoints() const { return points; }
+	//At size 1, so multiply by whatever size it's drawn at.
+	float GetWidth() const { return width; }
+};
@@ -25,6 +25,14 @@ Colour Colour::Desaturate(float factor) const
 	return this->Invert().Multiply(1.0f - factor).Invert();
 }
 
+uint32_t Colour::Pack() const
+{
+	uint32_t red = (uint32_t)(Clamp(r, 0.0f, 1.0f) * 255.0f + 0.5f);
+	uint32_t green = (uint32_t)(Clamp(g, 0.0f, 1.0f) * 255.0f + 0.5f);
+	uint32_t blue = (uint32_t)(Clamp(b, 0.0f, 1.0f) * 255.0f + 0.5f);
+	return red | (green << 8) | (blue << 16) | 0xFF000000u;
+}
+
 Colour Colour::Invert() const
 {
 	return Colour(1.0f - r, 1.0f - g, 1.0f - b);
@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 
 struct Colour
 {
@@ -10,6 +11,9 @@ struct Colour
 	Colour Desaturate(float factor) const;
 	Colour Invert() const;
 
+	//As 8 bits per channel, red in the lowest byte and alpha (always opaque) in the highest, so it reads as RGBA in memory.
+	uint32_t Pack() const;
+
 	Colour Darken() const { return Multiply(0.5f); }
 	Colour Lighten() const { return Desaturate(0.5f); }
 
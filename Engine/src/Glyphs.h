@@ -0,0 +1,198 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+//The built-in line font. Every glyph is a list of line segments (pairs of points) in a box 1 unit wide and about 1.6 tall,
+//all stored one after another in GlyphPoints. GlyphTable says where each character's points start and how many there are,
+//so looking one up doesn't allocate anything.
+
+struct GlyphPoint
+{
+	float x, y;
+};
+
+struct GlyphRange
+{
+	uint16_t offset = 0;
+	uint16_t count = 0;
+};
+
+constexpr GlyphPoint GlyphPoints[] = {
+	//A
+	{ 0.2f, 0.2f }, { 0.5f, 1.6f }, { 0.5f, 1.6f }, { 0.8f, 0.2f }, { 0.3f, 0.8f }, { 0.7f, 0.8f },
+	//B
+	{ 0.2f, 0.2f }, { 0.2f, 1.6f }, { 0.2f, 1.6f }, { 0.6f, 1.6f }, { 0.8f, 1.3f }, { 0.6f, 1.6f }, { 0.8f, 1.3f }, { 0.6f, 1.0f }, { 0.6f, 1.0f }, { 0.2f, 1.0f }, { 0.6f, 1.0f }, { 0.9f, 0.6f }, { 0.9f, 0.6f }, { 0.7f, 0.2f }, { 0.7f, 0.2f }, { 0.2f, 0.2f },
+	//C
+	{ 0.8f, 1.4f }, { 0.6f, 1.6f }, { 0.3f, 1.6f }, { 0.1f, 1.3f }, { 0.1f, 1.3f }, { 0.1f, 0.5f }, { 0.1f, 0.5f }, { 0.3f, 0.2f }, { 0.6f, 0.2f }, { 0.8f, 0.4f }, { 0.3f, 0.2f }, { 0.6f, 0.2f }, { 0.3f, 1.6f }, { 0.6f, 1.6f },
+	//D
+	{ 0.2f, 1.6f }, { 0.5f, 1.6f }, { 0.8f, 1.3f }, { 0.5f, 1.6f }, { 0.8f, 1.3f }, { 0.8f, 0.5f }, { 0.8f, 0.5f }, { 0.5f, 0.2f }, { 0.5f, 0.2f }, { 0.2f, 0.2f }, { 0.2f, 0.2f }, { 0.2f, 1.6f },
+	//E
+	{ 0.8f, 1.6f }, { 0.2f, 1.6f }, { 0.2f, 1.6f }, { 0.2f, 0.2f }, { 0.2f, 0.2f }, { 0.8f, 0.2f }, { 0.7f, 0.9f }, { 0.2f, 0.9f },
+	//F
+	{ 0.8f, 1.6f }, { 0.2f, 1.6f }, { 0.2f, 1.6f }, { 0.2f, 0.2f }, { 0.7f, 0.9f }, { 0.2f, 0.9f },
+	//G
+	{ 0.8f, 1.3f }, { 0.6f, 1.5f }, { 0.6f, 1.5f }, { 0.3f, 1.5f }, { 0.3f, 1.5f }, { 0.1f, 1.1f }, { 0.1f, 1.1f }, { 0.1f, 0.6f }, { 0.1f, 0.6f }, { 0.2f, 0.3f }, { 0.2f, 0.3f }, { 0.5f, 0.2f }, { 0.8f, 0.5f }, { 0.5f, 0.2f }, { 0.8f, 0.2f }, { 0.8f, 0.5f }, { 0.5f, 0.5f }, { 0.8f, 0.5f },
+	//H
+	{ 0.2f, 1.5f }, { 0.2f, 0.2f }, { 0.8f, 1.5f }, { 0.8f, 0.2f }, { 0.2f, 0.9f }, { 0.8f, 0.9f },
+	//I
+	{ 0.5f, 1.5f }, { 0.5f, 0.2f }, { 0.4f, 1.5f }, { 0.6f, 1.5f }, { 0.4f, 0.2f }, { 0.6f, 0.2f },
+	//J
+	{ 0.7f, 1.5f }, { 0.8f, 0.5f }, { 0.4f, 1.5f }, { 0.8f, 1.5f }, { 0.6f, 0.2f }, { 0.3f, 0.2f }, { 0.2f, 0.5f }, { 0.3f, 0.2f }, { 0.8f, 0.5f }, { 0.6f, 0.2f },
+	//K
+	{ 0.2f, 1.5f }, { 0.2f, 0.2f }, { 0.8f, 1.4f }, { 0.2f, 0.8f }, { 0.8f, 0.2f }, { 0.3f, 0.9f },
+	//L
+	{ 0.2f, 1.5f }, { 0.2f, 0.2f }, { 0.8f, 0.2f }, { 0.2f, 0.2f },
+	//M
+	{ 0.2f, 1.4f }, { 0.2f, 0.2f }, { 0.8f, 1.4f }, { 0.8f, 0.2f }, { 0.5f, 0.8f }, { 0.8f, 1.4f }, { 0.2f, 1.4f }, { 0.5f, 0.8f },
+	//N
+	{ 0.2f, 1.4f }, { 0.2f, 0.2f }, { 0.8f, 0.2f }, { 0.8f, 1.4f }, { 0.2f, 1.4f }, { 0.8f, 0.2f },
+	//O
+	{ 0.5f, 1.5f }, { 0.2f, 1.2f }, { 0.8f, 1.2f }, { 0.5f, 1.5f }, { 0.5f, 0.1f }, { 0.8f, 0.4f }, { 0.2f, 0.4f }, { 0.5f, 0.1f }, { 0.2f, 0.4f }, { 0.2f, 1.2f }, { 0.8f, 0.4f }, { 0.8f, 1.2f },
+	//P
+	{ 0.2f, 1.6f }, { 0.6f, 1.6f }, { 0.8f, 1.3f }, { 0.6f, 1.6f }, { 0.6f, 0.9f }, { 0.8f, 1.3f }, { 0.2f, 0.9f }, { 0.6f, 0.9f }, { 0.2f, 1.6f }, { 0.2f, 0.2f },
+	//Q
+	{ 0.5f, 1.6f }, { 0.1f, 1.2f }, { 0.1f, 0.5f }, { 0.4f, 0.2f }, { 0.9f, 0.5f }, { 0.9f, 1.2f }, { 0.5f, 1.6f }, { 0.9f, 1.2f }, { 0.1f, 1.2f }, { 0.1f, 0.5f }, { 0.4f, 0.2f }, { 0.9f, 0.5f }, { 0.5f, 0.5f }, { 0.8f, 0.2f },
+	//R
+	{ 0.2f, 1.6f }, { 0.7f, 1.6f }, { 0.9f, 1.2f }, { 0.7f, 0.9f }, { 0.2f, 0.9f }, { 0.7f, 0.9f }, { 0.7f, 1.6f }, { 0.9f, 1.2f }, { 0.4f, 0.9f }, { 0.8f, 0.2f }, { 0.2f, 0.2f }, { 0.2f, 1.6f },
+	//S
+	{ 0.9f, 1.3f }, { 0.7f, 1.6f }, { 0.3f, 1.6f }, { 0.1f, 1.3f }, { 0.2f, 0.9f }, { 0.8f, 0.7f }, { 0.9f, 0.3f }, { 0.5f, 0.1f }, { 0.1f, 0.3f }, { 0.5f, 0.1f }, { 0.8f, 0.7f }, { 0.9f, 0.3f }, { 0.7f, 1.6f }, { 0.3f, 1.6f }, { 0.1f, 1.3f }, { 0.2f, 0.9f },
+	//T
+	{ 0.1f, 1.5f }, { 0.9f, 1.5f }, { 0.5f, 1.5f }, { 0.5f, 0.2f },
+	//U
+	{ 0.8f, 1.5f }, { 0.8f, 0.6f }, { 0.4f, 0.2f }, { 0.2f, 0.6f }, { 0.2f, 1.5f }, { 0.2f, 0.6f }, { 0.8f, 0.6f }, { 0.6f, 0.2f }, { 0.4f, 0.2f }, { 0.6f, 0.2f },
+	//V
+	{ 0.9f, 1.5f }, { 0.5f, 0.2f }, { 0.5f, 0.2f }, { 0.1f, 1.5f },
+	//W
+	{ 0.9f, 1.5f }, { 0.8f, 0.2f }, { 0.2f, 0.2f }, { 0.1f, 1.5f }, { 0.5f, 0.8f }, { 0.8f, 0.2f }, { 0.5f, 0.8f }, { 0.2f, 0.2f },
+	//X
+	{ 0.8f, 0.2f }, { 0.2f, 1.5f }, { 0.2f, 0.2f }, { 0.8f, 1.5f },
+	//Y
+	{ 0.2f, 1.5f }, { 0.5f, 0.9f }, { 0.8f, 1.5f }, { 0.5f, 0.9f }, { 0.5f, 0.2f }, { 0.5f, 0.9f },
+	//Z
+	{ 0.2f, 1.5f }, { 0.8f, 1.5f }, { 0.8f, 0.2f }, { 0.2f, 0.2f }, { 0.8f, 1.5f }, { 0.2f, 0.2f },
+	//1
+	{ 0.3f, 1.3f }, { 0.5f, 1.4f }, { 0.5f, 1.4f }, { 0.5f, 0.2f }, { 0.3f, 0.2f }, { 0.7f, 0.2f },
+	//2
+	{ 0.2f, 1.3f }, { 0.4f, 1.5f }, { 0.6f, 0.8f }, { 0.7f, 1.3f }, { 0.2f, 0.3f }, { 0.6f, 0.8f }, { 0.8f, 0.3f }, { 0.2f, 0.3f }, { 0.4f, 1.5f }, { 0.7f, 1.3f },
+	//3
+	{ 0.2f, 1.3f }, { 0.5f, 1.5f }, { 0.4f, 0.9f }, { 0.8f, 1.2f }, { 0.5f, 1.5f }, { 0.8f, 1.2f }, { 0.7f, 0.7f }, { 0.4f, 0.9f }, { 0.8f, 0.4f }, { 0.7f, 0.7f }, { 0.2f, 0.3f }, { 0.4f, 0.2f }, { 0.8f, 0.4f }, { 0.4f, 0.2f },
+	//4
+	{ 0.6f, 1.5f }, { 0.2f, 0.8f }, { 0.8f, 0.8f }, { 0.2f, 0.8f }, { 0.6f, 0.9f }, { 0.5f, 0.2f },
+	//5
+	{ 0.8f, 1.4f }, { 0.2f, 1.4f }, { 0.2f, 0.9f }, { 0.6f, 0.8f }, { 0.8f, 0.5f }, { 0.6f, 0.2f }, { 0.6f, 0.8f }, { 0.8f, 0.5f }, { 0.2f, 1.4f }, { 0.2f, 0.9f }, { 0.1f, 0.3f }, { 0.6f, 0.2f },
+	//6
+	{ 0.7f, 1.5f }, { 0.3f, 1.2f }, { 0.2f, 0.8f }, { 0.2f, 0.4f }, { 0.5f, 0.2f }, { 0.8f, 0.4f }, { 0.9f, 0.7f }, { 0.6f, 0.9f }, { 0.8f, 0.4f }, { 0.9f, 0.7f }, { 0.2f, 0.4f }, { 0.5f, 0.2f }, { 0.3f, 1.2f }, { 0.2f, 0.8f }, { 0.2f, 0.8f }, { 0.6f, 0.9f },
+	//7
+	{ 0.2f, 1.4f }, { 0.8f, 1.4f }, { 0.5f, 0.8f }, { 0.4f, 0.2f }, { 0.5f, 0.8f }, { 0.8f, 1.4f },
+	//8
+	{ 0.5f, 1.5f }, { 0.3f, 1.3f }, { 0.3f, 1.0f }, { 0.8f, 0.6f }, { 0.8f, 0.3f }, { 0.5f, 0.1f }, { 0.2f, 0.3f }, { 0.5f, 0.1f }, { 0.2f, 0.6f }, { 0.2f, 0.3f }, { 0.8f, 0.6f }, { 0.8f, 0.3f }, { 0.7f, 1.3f }, { 0.7f, 1.0f }, { 0.2f, 0.6f }, { 0.7f, 1.0f }, { 0.5f, 1.5f }, { 0.7f, 1.3f }, { 0.3f, 1.3f }, { 0.3f, 1.0f },
+	//9
+	{ 0.2f, 1.3f }, { 0.4f, 1.5f }, { 0.7f, 1.5f }, { 0.8f, 1.1f }, { 0.7f, 0.6f }, { 0.2f, 0.2f }, { 0.2f, 1.0f }, { 0.5f, 0.9f }, { 0.8f, 1.1f }, { 0.5f, 0.9f }, { 0.8f, 1.1f }, { 0.7f, 0.6f }, { 0.2f, 1.3f }, { 0.2f, 1.0f }, { 0.4f, 1.5f }, { 0.7f, 1.5f },
+	//0
+	{ 0.5f, 1.5f }, { 0.2f, 1.1f }, { 0.2f, 0.5f }, { 0.5f, 0.2f }, { 0.8f, 0.5f }, { 0.8f, 1.1f }, { 0.5f, 1.5f }, { 0.8f, 1.1f }, { 0.2f, 1.1f }, { 0.2f, 0.5f }, { 0.8f, 0.5f }, { 0.5f, 0.2f }, { 0.2f, 0.2f }, { 0.8f, 1.5f },
+	//!
+	{ 0.5f, 1.5f }, { 0.5f, 0.6f }, { 0.4f, 0.3f }, { 0.6f, 0.1f }, { 0.6f, 0.3f }, { 0.4f, 0.1f },
+	//"
+	{ 0.4f, 1.4f }, { 0.4f, 1.2f }, { 0.6f, 1.4f }, { 0.6f, 1.2f },
+	//#
+	{ 0.3f, 1.3f }, { 0.3f, 0.6f }, { 0.7f, 1.3f }, { 0.7f, 0.6f }, { 0.1f, 1.1f }, { 0.9f, 1.1f }, { 0.1f, 0.8f }, { 0.9f, 0.8f },
+	//$
+	{ 0.5f, 1.5f }, { 0.8f, 1.3f }, { 0.2f, 1.2f }, { 0.2f, 0.9f }, { 0.8f, 0.7f }, { 0.8f, 0.4f }, { 0.5f, 0.2f }, { 0.2f, 0.4f }, { 0.5f, 0.2f }, { 0.8f, 0.4f }, { 0.2f, 0.9f }, { 0.8f, 0.7f }, { 0.5f, 1.5f }, { 0.2f, 1.2f }, { 0.4f, 1.5f }, { 0.4f, 0.2f }, { 0.6f, 1.5f }, { 0.6f, 0.2f },
+	//%
+	{ 0.8f, 1.4f }, { 0.2f, 0.3f }, { 0.3f, 1.1f }, { 0.2f, 1.0f }, { 0.3f, 0.9f }, { 0.4f, 1.0f }, { 0.2f, 1.0f }, { 0.3f, 0.9f }, { 0.3f, 1.1f }, { 0.4f, 1.0f }, { 0.6f, 0.7f }, { 0.7f, 0.8f }, { 0.7f, 0.6f }, { 0.8f, 0.7f }, { 0.6f, 0.7f }, { 0.7f, 0.6f }, { 0.7f, 0.8f }, { 0.8f, 0.7f },
+	//&
+	{ 0.5f, 1.5f }, { 0.2f, 1.3f }, { 0.2f, 1.0f }, { 0.6f, 0.7f }, { 0.9f, 0.5f }, { 0.4f, 0.2f }, { 0.2f, 0.4f }, { 0.4f, 0.2f }, { 0.2f, 0.6f }, { 0.2f, 0.4f }, { 0.6f, 0.7f }, { 0.8f, 0.2f }, { 0.2f, 0.6f }, { 0.7f, 1.0f }, { 0.5f, 1.5f }, { 0.7f, 1.3f }, { 0.2f, 1.3f }, { 0.2f, 1.0f },
+	//'
+	{ 0.5f, 1.4f }, { 0.5f, 1.2f },
+	//(
+	{ 0.5f, 1.5f }, { 0.2f, 1.1f }, { 0.2f, 0.6f }, { 0.5f, 0.2f }, { 0.2f, 1.1f }, { 0.2f, 0.6f },
+	//)
+	{ 0.5f, 1.5f }, { 0.8f, 1.1f }, { 0.8f, 0.6f }, { 0.5f, 0.2f }, { 0.8f, 1.1f }, { 0.8f, 0.6f },
+	//*
+	{ 0.4f, 1.4f }, { 0.6f, 1.0f }, { 0.6f, 1.4f }, { 0.4f, 1.0f }, { 0.3f, 1.2f }, { 0.7f, 1.2f },
+	//+
+	{ 0.5f, 1.1f }, { 0.5f, 0.5f }, { 0.2f, 0.8f }, { 0.8f, 0.8f },
+	//,
+	{ 0.6f, 0.4f }, { 0.4f, 0.2f },
+	//-
+	{ 0.2f, 0.9f }, { 0.8f, 0.9f },
+	//.
+	{ 0.4f, 0.3f }, { 0.6f, 0.3f }, { 0.5f, 0.4f }, { 0.5f, 0.2f },
+	///
+	{ 0.8f, 1.4f }, { 0.2f, 0.2f },
+	//:
+	{ 0.6f, 1.3f }, { 0.5f, 1.2f }, { 0.4f, 1.3f }, { 0.5f, 1.4f }, { 0.5f, 1.4f }, { 0.6f, 1.3f }, { 0.4f, 1.3f }, { 0.5f, 1.2f }, { 0.5f, 0.5f }, { 0.4f, 0.4f }, { 0.5f, 0.3f }, { 0.6f, 0.4f }, { 0.5f, 0.5f }, { 0.6f, 0.4f }, { 0.4f, 0.4f }, { 0.5f, 0.3f },
+	//;
+	{ 0.6f, 1.3f }, { 0.5f, 1.2f }, { 0.4f, 1.3f }, { 0.5f, 1.4f }, { 0.5f, 1.4f }, { 0.6f, 1.3f }, { 0.4f, 1.3f }, { 0.5f, 1.2f }, { 0.6f, 0.5f }, { 0.4f, 0.2f },
+	//<
+	{ 0.8f, 1.2f }, { 0.1f, 0.9f }, { 0.8f, 0.6f }, { 0.1f, 0.9f },
+	//=
+	{ 0.8f, 1.2f }, { 0.2f, 1.2f }, { 0.8f, 0.6f }, { 0.2f, 0.6f },
+	//>
+	{ 0.9f, 0.9f }, { 0.2f, 1.2f }, { 0.9f, 0.9f }, { 0.2f, 0.6f },
+	//?
+	{ 0.1f, 1.2f }, { 0.3f, 1.5f }, { 0.7f, 1.5f }, { 0.9f, 1.3f }, { 0.3f, 1.5f }, { 0.7f, 1.5f }, { 0.8f, 1.0f }, { 0.9f, 1.3f }, { 0.5f, 0.8f }, { 0.8f, 1.0f }, { 0.5f, 0.5f }, { 0.5f, 0.8f }, { 0.5f, 0.3f }, { 0.4f, 0.2f }, { 0.6f, 0.2f }, { 0.5f, 0.1f }, { 0.6f, 0.2f }, { 0.5f, 0.3f }, { 0.4f, 0.2f }, { 0.5f, 0.1f },
+	//@
+	{ 0.8f, 1.0f }, { 0.5f, 1.2f }, { 0.3f, 1.0f }, { 0.3f, 0.6f }, { 0.5f, 0.5f }, { 0.8f, 0.7f }, { 0.7f, 1.5f }, { 0.8f, 0.7f }, { 0.5f, 1.2f }, { 0.3f, 1.0f }, { 0.5f, 0.5f }, { 0.3f, 0.6f }, { 0.4f, 1.5f }, { 0.7f, 1.5f }, { 0.1f, 1.1f }, { 0.4f, 1.5f }, { 0.1f, 0.5f }, { 0.1f, 1.1f }, { 0.4f, 0.2f }, { 0.8f, 0.3f }, { 0.1f, 0.5f }, { 0.4f, 0.2f },
+	//[
+	{ 0.5f, 1.5f }, { 0.2f, 1.5f }, { 0.2f, 0.2f }, { 0.5f, 0.2f }, { 0.2f, 0.2f }, { 0.2f, 1.5f },
+	//]
+	{ 0.5f, 1.5f }, { 0.8f, 1.5f }, { 0.8f, 0.2f }, { 0.5f, 0.2f }, { 0.8f, 0.2f }, { 0.8f, 1.5f },
+	//Backslash
+	{ 0.2f, 1.5f }, { 0.8f, 0.2f },
+	//^
+	{ 0.5f, 1.5f }, { 0.3f, 1.2f }, { 0.7f, 1.2f }, { 0.5f, 1.5f },
+	//_
+	{ 0.2f, 0.2f }, { 0.8f, 0.2f },
+	//`
+	{ 0.4f, 1.4f }, { 0.6f, 1.2f },
+	//{
+	{ 0.5f, 0.2f }, { 0.3f, 0.3f }, { 0.2f, 0.9f }, { 0.3f, 0.7f }, { 0.3f, 0.7f }, { 0.3f, 0.3f }, { 0.3f, 1.0f }, { 0.3f, 1.3f }, { 0.3f, 1.3f }, { 0.5f, 1.4f }, { 0.3f, 1.0f }, { 0.2f, 0.8f },
+	//}
+	{ 0.5f, 0.2f }, { 0.7f, 0.3f }, { 0.8f, 0.9f }, { 0.7f, 0.7f }, { 0.7f, 0.7f }, { 0.7f, 0.3f }, { 0.7f, 1.0f }, { 0.7f, 1.3f }, { 0.7f, 1.3f }, { 0.5f, 1.4f }, { 0.7f, 1.0f }, { 0.8f, 0.8f },
+	//|
+	{ 0.5f, 0.2f }, { 0.5f, 1.4f },
+	//~
+	{ 0.1f, 0.9f }, { 0.3f, 1.1f }, { 0.7f, 0.9f }, { 0.9f, 1.1f }, { 0.3f, 1.1f }, { 0.7f, 0.9f },
+};
+
+//How many points each glyph has, in the same order as GlyphPoints.
+struct GlyphLength
+{
+	char character;
+	uint16_t count;
+};
+
+constexpr GlyphLength GlyphLengths[] = {
+	{ 'A', 6 }, { 'B', 16 }, { 'C', 14 }, { 'D', 12 }, { 'E', 8 }, { 'F', 6 }, { 'G', 18 }, { 'H', 6 },
+	{ 'I', 6 }, { 'J', 10 }, { 'K', 6 }, { 'L', 4 }, { 'M', 8 }, { 'N', 6 }, { 'O', 12 }, { 'P', 10 },
+	{ 'Q', 14 }, { 'R', 12 }, { 'S', 16 }, { 'T', 4 }, { 'U', 10 }, { 'V', 4 }, { 'W', 8 }, { 'X', 4 },
+	{ 'Y', 6 }, { 'Z', 6 }, { '1', 6 }, { '2', 10 }, { '3', 14 }, { '4', 6 }, { '5', 12 }, { '6', 16 },
+	{ '7', 6 }, { '8', 20 }, { '9', 16 }, { '0', 14 }, { '!', 6 }, { '"', 4 }, { '#', 8 }, { '$', 18 },
+	{ '%', 18 }, { '&', 18 }, { '\'', 2 }, { '(', 6 }, { ')', 6 }, { '*', 6 }, { '+', 4 }, { ',', 2 },
+	{ '-', 2 }, { '.', 4 }, { '/', 2 }, { ':', 16 }, { ';', 10 }, { '<', 4 }, { '=', 4 }, { '>', 4 },
+	{ '?', 20 }, { '@', 22 }, { '[', 6 }, { ']', 6 }, { '\\', 2 }, { '^', 4 }, { '_', 2 }, { '`', 2 },
+	{ '{', 12 }, { '}', 12 }, { '|', 2 }, { '~', 6 },
+};
+
+constexpr std::array<GlyphRange, 128> MakeGlyphTable()
+{
+	std::array<GlyphRange, 128> table = {};
+	uint16_t offset = 0;
+	for (const GlyphLength& glyph : GlyphLengths)
+	{
+		table[(unsigned char)glyph.character] = { offset, glyph.count };
+		offset += glyph.count;
+	}
+	//Lower case letters look the same as upper case ones.
+	for (char character = 'a'; character <= 'z'; character++)
+	{
+		table[(unsigned char)character] = table[(unsigned char)(character - 'a' + 'A')];
+	}
+	return table;
+}
+
+constexpr std::array<GlyphRange, 128> GlyphTable = MakeGlyphTable();
+
+static_assert(GlyphTable['~'].offset + GlyphTable['~'].count == sizeof(GlyphPoints) / sizeof(GlyphPoint), "GlyphLengths doesn't match GlyphPoints");
\ No newline at end of file
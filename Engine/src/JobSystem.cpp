@@ -0,0 +1,144 @@
+#include "JobSystem.h"
+#include "Profiler.h"
+#include <string>
+
+//Which queue the current thread owns. Anything that isn't one of our workers shares queue 0.
+static thread_local const JobSystem* currentSystem = nullptr;
+static thread_local int currentQueue = 0;
+
+JobSystem::JobSystem(int threadCount)
+{
+	if (threadCount <= 0) threadCount = (int)std::thread::hardware_concurrency();
+	if (threadCount <= 0) threadCount = 1;
+
+	for (int i = 0; i < threadCount; i++)
+	{
+		queues.push_back(std::make_unique<WorkQueue>());
+	}
+
+	//The creating thread counts as one of the threads, so it doesn't get a worker.
+	for (int i = 1; i < threadCount; i++)
+	{
+		workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+	}
+}
+
+JobSystem::~JobSystem()
+{
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+		running = false;
+	}
+	wakeCondition.notify_all();
+
+	for (std::thread& worker : workers)
+	{
+		worker.join();
+	}
+}
+
+void JobSystem::Submit(Job job, JobCounter& counter)
+{
+	Push(std::move(job), counter);
+	WakeWorkers(1);
+}
+
+void JobSystem::Wait(JobCounter& counter)
+{
+	const int queueIndex = GetCurrentQueue();
+
+	while (counter.pending.load(std::memory_order_acquire) > 0)
+	{
+		//Help out instead of sitting idle. If there's nothing left to take, the last few jobs are already running elsewhere.
+		if (!TryRunJob(queueIndex)) std::this_thread::yield();
+	}
+}
+
+void JobSystem::Push(Job job, JobCounter& counter)
+{
+	counter.pending.fetch_add(1, std::memory_order_relaxed);
+
+	WorkQueue& queue = *queues[GetCurrentQueue()];
+	{
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.jobs.push_back({ std::move(job), &counter });
+	}
+
+	queuedJobs.fetch_add(1, std::memory_order_release);
+}
+
+void JobSystem::WakeWorkers(int count)
+{
+	if (workers.empty()) return;
+
+	//Taking the lock (even briefly) makes sure a worker can't check for jobs and then go to sleep in between us queueing a job and
+	//notifying, which would leave the job sitting there.
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+	}
+
+	if (count == 1) wakeCondition.notify_one();
+	else wakeCondition.notify_all();
+}
+
+void JobSystem::WorkerLoop(int queueIndex)
+{
+	currentSystem = this;
+	currentQueue = queueIndex;
+	Profiler::SetThreadName(("Worker " + std::to_string(queueIndex)).c_str());
+
+	while (true)
+	{
+		if (TryRunJob(queueIndex)) continue;
+
+		std::unique_lock<std::mutex> lock(sleepMutex);
+		wakeCondition.wait(lock, [this]() { return queuedJobs.load(std::memory_order_acquire) > 0 || !running; });
+
+		if (!running) return;
+	}
+}
+
+bool JobSystem::TryRunJob(int queueIndex)
+{
+	QueuedJob job;
+	bool found = TryPop(queueIndex, false, job);
+
+	//Our own queue is empty, so go looking through everyone else's, starting with our neighbour so the thieves spread out.
+	for (int i = 1; !found && i < (int)queues.size(); i++)
+	{
+		found = TryPop((queueIndex + i) % (int)queues.size(), true, job);
+	}
+
+	if (!found) return false;
+
+	job.job();
+	job.counter->pending.fetch_sub(1, std::memory_order_release);
+	return true;
+}
+
+bool JobSystem::TryPop(int queueIndex, bool steal, QueuedJob& out)
+{
+	WorkQueue& queue = *queues[queueIndex];
+	std::lock_guard<std::mutex> lock(queue.mutex);
+
+	if (queue.jobs.empty()) return false;
+
+	if (steal)
+	{
+		out = std::move(queue.jobs.front());
+		queue.jobs.pop_front();
+	}
+	else
+	{
+		out = std::move(queue.jobs.back());
+		queue.jobs.pop_back();
+	}
+
+	queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+	return true;
+}
+
+int JobSystem::GetCurrentQueue() const
+{
+	return (currentSystem == this) ? currentQueue : 0;
+}
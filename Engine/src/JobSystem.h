@@ -0,0 +1,97 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//Tracks a group of jobs, so you can wait for all of them to finish.
+struct JobCounter
+{
+	std::atomic<int> pending = 0;
+};
+
+//A small work-stealing job scheduler. Every thread has its own queue of jobs. Threads take jobs from the back of their own
+//queue (so they work on whatever they queued most recently, which is probably still in cache), and once that runs dry they
+//steal from the front of someone else's. Big batches of jobs end up spread across every core without any central queue.
+//
+//Waiting on a counter doesn't block - the waiting thread runs jobs itself until the counter reaches zero.
+class JobSystem
+{
+public:
+	using Job = std::function<void()>;
+
+	//The thread count includes the thread that created the job system. 0 means one thread per core.
+	explicit JobSystem(int threadCount = 0);
+	~JobSystem();
+	JobSystem(const JobSystem& other) = delete;
+	JobSystem& operator=(const JobSystem& other) = delete;
+
+	void Submit(Job job, JobCounter& counter);
+	void Wait(JobCounter& counter);
+
+	//Splits [0, count) into chunks of at most grainSize and calls function(begin, end) for each one, spread over every thread.
+	//Returns once all of them are done.
+	template <typename Function>
+	void ParallelFor(int count, int grainSize, Function&& function);
+
+	int GetThreadCount() const { return (int)queues.size(); }
+
+private:
+	struct QueuedJob
+	{
+		Job job;
+		JobCounter* counter;
+	};
+
+	struct WorkQueue
+	{
+		std::mutex mutex;
+		std::deque<QueuedJob> jobs;
+	};
+
+	void Push(Job job, JobCounter& counter);
+	void WakeWorkers(int count);
+	void WorkerLoop(int queueIndex);
+	bool TryRunJob(int queueIndex);
+	bool TryPop(int queueIndex, bool steal, QueuedJob& out);
+	int GetCurrentQueue() const;
+
+	//Queue 0 belongs to whichever thread(s) aren't workers, e.g. the main thread.
+	std::vector<std::unique_ptr<WorkQueue>> queues;
+	std::vector<std::thread> workers;
+
+	std::mutex sleepMutex;
+	std::condition_variable wakeCondition;
+	std::atomic<int> queuedJobs = 0;
+	std::atomic<bool> running = true;
+};
+
+template <typename Function>
+void JobSystem::ParallelFor(int count, int grainSize, Function&& function)
+{
+	if (count <= 0) return;
+	if (grainSize < 1) grainSize = 1;
+
+	//Not worth the overhead of going wide.
+	if (count <= grainSize || GetThreadCount() == 1)
+	{
+		function(0, count);
+		return;
+	}
+
+	JobCounter counter;
+	int jobCount = 0;
+	for (int begin = 0; begin < count; begin += grainSize)
+	{
+		const int end = (begin + grainSize < count) ? begin + grainSize : count;
+		Push([&function, begin, end]() { function(begin, end); }, counter);
+		jobCount++;
+	}
+
+	WakeWorkers(jobCount);
+	Wait(counter);
+}
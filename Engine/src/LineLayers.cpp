@@ -0,0 +1,59 @@
+#include "LineLayers.h"
+
+LineLayers::Layer& LineLayers::GetLayer(std::string_view name)
+{
+	for (Layer& layer : layers)
+	{
+		if (layer.name == name) return layer;
+	}
+
+	Layer& layer = layers.emplace_back();
+	layer.name = name;
+	layer.lines = std::make_unique<LineRenderer>();
+	layer.lines->Initialise();
+	return layer;
+}
+
+LineRenderer& LineLayers::Get(std::string_view name)
+{
+	return *GetLayer(name).lines;
+}
+
+void LineLayers::MarkDirty(std::string_view name)
+{
+	GetLayer(name).dirty = true;
+}
+
+bool LineLayers::BeginRebuild(std::string_view name)
+{
+	Layer& layer = GetLayer(name);
+	if (!layer.dirty) return false;
+
+	layer.lines->Clear();
+	layer.dirty = false;
+	layer.needsCompile = true;
+	return true;
+}
+
+void LineLayers::SetVisible(std::string_view name, bool visible)
+{
+	GetLayer(name).visible = visible;
+}
+
+bool LineLayers::IsVisible(std::string_view name)
+{
+	return GetLayer(name).visible;
+}
+
+void LineLayers::Draw()
+{
+	for (Layer& layer : layers)
+	{
+		if (layer.needsCompile)
+		{
+			layer.lines->Compile();
+			layer.needsCompile = false;
+		}
+		if (layer.visible) layer.lines->Draw();
+	}
+}
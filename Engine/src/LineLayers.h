@@ -0,0 +1,46 @@
+#pragma once
+
+#include "LineRenderer.h"
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+//Named sets of lines that stay the same from frame to frame, like the grid or anything in the world that never moves. Unlike
+//the other line renderers they don't get cleared every frame, so they cost nothing until something marks them dirty.
+//
+//To (re)draw one, check BeginRebuild() and draw into Get() if it says so:
+//	if (layers->BeginRebuild("Planes")) { ...draw into layers->Get("Planes")... }
+//
+//NOTE: Layers don't know where the camera is, so nothing drawn into them gets culled. They're drawn in the order they were made.
+class LineLayers
+{
+private:
+	struct Layer
+	{
+		std::string name;
+		std::unique_ptr<LineRenderer> lines;
+		bool dirty = true;
+		bool visible = true;
+		bool needsCompile = false;
+	};
+
+	std::vector<Layer> layers;
+
+	Layer& GetLayer(std::string_view name);
+
+public:
+	//Makes the layer if it doesn't exist yet. New layers start out dirty.
+	LineRenderer& Get(std::string_view name);
+
+	void MarkDirty(std::string_view name);
+
+	//If the layer's dirty, clears it ready to be drawn again and returns true.
+	bool BeginRebuild(std::string_view name);
+
+	void SetVisible(std::string_view name, bool visible);
+	bool IsVisible(std::string_view name);
+
+	//Uploads anything that's been rebuilt, then draws every visible layer.
+	void Draw();
+};
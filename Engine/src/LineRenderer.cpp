@@ -1,18 +1,32 @@
 #include "LineRenderer.h"
+#include "Profiler.h"
+#include <cstddef>
 #include <iostream>
 
+//Vertices per region to start with. Big enough for a normal frame, and it doubles if not.
+constexpr int InitialVertexCapacity = 1 << 16;
+
+//Text with characters smaller than this many pixels across can't be read anyway, so it isn't drawn.
+constexpr float MinLegibleTextPixels = 3.0f;
+
 void LineRenderer::Initialise()
 {
-	glGenBuffers(1, &positionBufferID);
-	glGenBuffers(1, &colourBufferID);
+	glCreateVertexArrays(1, &vertexArrayID);
+	glVertexArrayAttribFormat(vertexArrayID, 0, 2, GL_FLOAT, GL_FALSE, offsetof(LineVertex, position));
+	glVertexArrayAttribFormat(vertexArrayID, 1, 4, GL_UNSIGNED_BYTE, GL_TRUE, offsetof(LineVertex, colour));
+	glVertexArrayAttribBinding(vertexArrayID, 0, 0);
+	glVertexArrayAttribBinding(vertexArrayID, 1, 0);
+	glEnableVertexArrayAttrib(vertexArrayID, 0);
+	glEnableVertexArrayAttrib(vertexArrayID, 1);
+
+	vertices.Initialise(vertexArrayID, 0, sizeof(LineVertex), InitialVertexCapacity);
 	initialised = true;
 }
 LineRenderer::~LineRenderer()
 {
 	if (initialised)
 	{
-		glDeleteBuffers(1, &positionBufferID);
-		glDeleteBuffers(1, &colourBufferID);
+		glDeleteVertexArrays(1, &vertexArrayID);
 		initialised = false;
 	}
 }
@@ -30,10 +44,9 @@ void LineRenderer::DrawLineSegment(Vec2 start, Vec2 end)
 
 void LineRenderer::DrawLineSegment(Vec2 start, Vec2 end, Colour colour)
 {
-	positions.push_back(start);
-	positions.push_back(end);
-	colours.push_back(colour);
-	colours.push_back(colour);
+	if (!view.OverlapsSegment(start, end)) return;
+	AddVertex(start, colour);
+	AddVertex(end, colour);
 }
 
 void LineRenderer::DrawLineWithArrow(Vec2 start, Vec2 end, float arrowSize)
@@ -43,6 +56,9 @@ void LineRenderer::DrawLineWithArrow(Vec2 start, Vec2 end, float arrowSize)
 
 void LineRenderer::DrawLineWithArrow(Vec2 start, Vec2 end, Colour colour, float arrowSize)
 {
+	if (!view.Overlaps(Vec2(fminf(start.x, end.x), fminf(start.y, end.y)) - Vec2(arrowSize, arrowSize),
+		Vec2(fmaxf(start.x, end.x), fmaxf(start.y, end.y)) + Vec2(arrowSize, arrowSize))) return;
+
 	Vec2 lineDirection = (end - start).GetNormalised();
 	Vec2 linePerp = lineDirection.GetRotatedBy90() * 0.5f;
 
@@ -64,10 +80,11 @@ void LineRenderer::FinishLineLoop()
 {
 	if (lineActive)
 	{
-		positions.push_back(lastPos);
-		positions.push_back(firstPos);
-		colours.push_back(lastColour);
-		colours.push_back(firstColour);
+		if (view.OverlapsSegment(lastPos, firstPos))
+		{
+			AddVertex(lastPos, lastColour);
+			AddVertex(firstPos, firstColour);
+		}
 		lineActive = false;
 	}
 }
@@ -81,10 +98,11 @@ void LineRenderer::AddPointToLine(Vec2 point, Colour colour)
 {
 	if (lineActive)
 	{
-		positions.push_back(lastPos);
-		positions.push_back(point);
-		colours.push_back(lastColour);
-		colours.push_back(colour);
+		if (view.OverlapsSegment(lastPos, point))
+		{
+			AddVertex(lastPos, lastColour);
+			AddVertex(point, colour);
+		}
 		lastPos = point;
 		lastColour = colour;
 	}
@@ -105,14 +123,11 @@ void LineRenderer::DrawCross(Vec2 centre, float size)
 
 void LineRenderer::DrawCross(Vec2 centre, float size, Colour colour)
 {
-	positions.push_back({ centre.x - size, centre.y - size });
-	positions.push_back({ centre.x + size, centre.y + size });
-	positions.push_back({ centre.x + size, centre.y - size });
-	positions.push_back({ centre.x - size, centre.y + size });
-	colours.push_back(colour);
-	colours.push_back(colour);
-	colours.push_back(colour);
-	colours.push_back(colour);
+	if (!view.Overlaps(centre, size)) return;
+	AddVertex({ centre.x - size, centre.y - size }, colour);
+	AddVertex({ centre.x + size, centre.y + size }, colour);
+	AddVertex({ centre.x + size, centre.y - size }, colour);
+	AddVertex({ centre.x - size, centre.y + size }, colour);
 }
 
 void LineRenderer::DrawCircle(Vec2 centre, float size)
@@ -132,8 +147,16 @@ void LineRenderer::DrawCircle(Vec2 centre, float size, int segmentCount)
 
 void LineRenderer::DrawCircle(Vec2 centre, float size, Colour colour, int segmentCount)
 {
-	if (centre.x > cameraXMin - size && centre.x < cameraXMax + size && centre.y > cameraYMin - size && centre.y < cameraYMax + size)
+	if (view.Overlaps(centre, size))
 	{
+		//Too small to see the shape of it, so just mark where it is.
+		if (view.IsSubPixel(size * 2.0f))
+		{
+			AddVertex(centre, colour);
+			AddVertex(centre + Vec2(view.GetPixelSize(), 0.0f), colour);
+			return;
+		}
+
 		float cosAngle = cos(2 * PI / segmentCount);
 		float sinAngle = sin(2 * PI / segmentCount);
 
@@ -141,16 +164,12 @@ void LineRenderer::DrawCircle(Vec2 centre, float size, Colour colour, int segmen
 
 		for (int i = 0; i < segmentCount - 1; i++)
 		{
-			positions.push_back(centre + plotPoint);
+			AddVertex(centre + plotPoint, colour);
 			plotPoint.RotateBy(cosAngle, sinAngle);
-			positions.push_back(centre + plotPoint);
-			colours.push_back(colour);
-			colours.push_back(colour);
+			AddVertex(centre + plotPoint, colour);
 		}
-		positions.push_back(centre + plotPoint);
-		positions.push_back(centre + Vec2(0, size));
-		colours.push_back(colour);
-		colours.push_back(colour);
+		AddVertex(centre + plotPoint, colour);
+		AddVertex(centre + Vec2(0, size), colour);
 	}
 }
 
@@ -161,6 +180,8 @@ void LineRenderer::DrawCircleArc(Vec2 centre, float size, float startBearing, fl
 
 void LineRenderer::DrawCircleArc(Vec2 centre, float size, float startBearing, float endBearing, Colour colour, int fullSegmentCount)
 {
+	if (!view.Overlaps(centre, size)) return;
+
 	float angleDiff = endBearing - startBearing;
 	if (angleDiff < 0) angleDiff += 2.0f * PI;
 
@@ -178,11 +199,9 @@ void LineRenderer::DrawCircleArc(Vec2 centre, float size, float startBearing, fl
 
 	for (int i = 0; i < segmentCount; i++)
 	{
-		positions.push_back(centre + plotPoint);
+		AddVertex(centre + plotPoint, colour);
 		plotPoint.RotateBy(cosAngle, sinAngle);
-		positions.push_back(centre + plotPoint);
-		colours.push_back(colour);
-		colours.push_back(colour);
+		AddVertex(centre + plotPoint, colour);
 	}
 
 }
@@ -190,69 +209,75 @@ void LineRenderer::DrawCircleArc(Vec2 centre, float size, float startBearing, fl
 void LineRenderer::Clear()
 {
 	lineActive = false;
-	positions.clear();
-	colours.clear();
+	//Move on to the next region, so we're not writing over whatever the GPU might still be drawing from the last one.
+	vertices.NextRegion();
+	compiledCount = 0;
 }
 
 void LineRenderer::Compile()
 {
-	if (positions.size() != 0)
-	{
-		glBindBuffer(GL_ARRAY_BUFFER, positionBufferID);
-		glBufferData(GL_ARRAY_BUFFER, sizeof(Vec2) * positions.size(), positions.data(), GL_DYNAMIC_DRAW);
-		glBindBuffer(GL_ARRAY_BUFFER, colourBufferID);
-		glBufferData(GL_ARRAY_BUFFER, sizeof(Colour) * colours.size(), colours.data(), GL_DYNAMIC_DRAW);
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
-	}
+	PROFILE_ZONE("LineRenderer::Compile");
+	//The buffers are mapped coherently, so everything's already on its way to the GPU. All that's left is to remember how much to draw.
+	compiledCount = vertices.GetCount();
 }
 
 void LineRenderer::Draw()
 {
-	if (positions.size() != 0)
+	if (compiledCount != 0)
 	{
-		glBindBuffer(GL_ARRAY_BUFFER, positionBufferID);
-		glEnableVertexAttribArray(0);
-		glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Vec2), 0);
-
-		glBindBuffer(GL_ARRAY_BUFFER, colourBufferID);
-		glEnableVertexAttribArray(1);
-		glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Colour), 0);
-
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-		glDrawArrays(GL_LINES, 0, (GLsizei)positions.size());
+		glBindVertexArray(vertexArrayID);
+		glDrawArrays(GL_LINES, vertices.GetFirst(), compiledCount);
+		glBindVertexArray(0);
+		vertices.Fence();
 	}
 }
 
-void LineRenderer::UpdateWithCameraInfo(Vec2 pos, float height, float aspect)
+void LineRenderer::UpdateWithCameraInfo(Vec2 pos, float height, float aspect, int viewportPixelHeight)
 {
-	float halfHeight = height / 2;
-	float halfWidth = halfHeight * aspect;
-	cameraXMin = pos.x - halfWidth;
-	cameraXMax = pos.x + halfWidth;
-	cameraYMin = pos.y - halfHeight;
-	cameraYMax = pos.y + halfHeight;
-	
-	cameraZoomFactor = 10.0f / height;
+	view.Update(pos, height, aspect, viewportPixelHeight);
 }
 
 
 
-float LineRenderer::DrawText(std::string text, Vec2 pos, float size)
+float LineRenderer::DrawText(std::string_view text, Vec2 pos, float size)
 {
 	return DrawText(text, pos, size, currentColour);
 }
 
-float LineRenderer::DrawText(std::string text, Vec2 pos, float size, Colour colour)
+float LineRenderer::DrawText(std::string_view text, Vec2 pos, float size, Colour colour)
 {
+	//Every visible character is size wide, so if the whole line is off screen or too small to read, skip straight to the end.
+	if (view.IsSmallerThan(size, MinLegibleTextPixels) || !view.Overlaps(pos, pos + Vec2(size * text.size(), size * 1.6f)))
+	{
+		return GetTextWidth(text, size);
+	}
+
 	Vec2 currentPos = pos;
-	for (int i = 0; i < text.size(); i++)
+	for (char character : text)
 	{
-		currentPos.x += DrawChar(text[i], currentPos, size, colour);
+		currentPos.x += DrawChar(character, currentPos, size, colour);
 	}
 	return currentPos.x - pos.x;
 }
 
+float LineRenderer::DrawText(const CachedText& text, Vec2 pos, float size)
+{
+	return DrawText(text, pos, size, currentColour);
+}
+
+float LineRenderer::DrawText(const CachedText& text, Vec2 pos, float size, Colour colour)
+{
+	const float width = text.GetWidth() * size;
+	if (view.IsSmallerThan(size, MinLegibleTextPixels) || !view.Overlaps(pos, pos + Vec2(width, size * 1.6f))) return width;
+
+	const uint32_t packed = colour.Pack();
+	for (const GlyphPoint& point : text.GetPoints())
+	{
+		vertices.Push(LineVertex{ { point.x * size + pos.x, point.y * size + pos.y }, packed });
+	}
+	return width;
+}
+
 float LineRenderer::DrawChar(char character, Vec2 pos, float size)
 {
 	return DrawChar(character, pos, size, currentColour);
@@ -260,193 +285,43 @@ float LineRenderer::DrawChar(char character, Vec2 pos, float size)
 
 float LineRenderer::DrawChar(char character, Vec2 pos, float size, Colour colour)
 {
-	std::vector<Vec2> points = GetGlyph(character);
-	if (points.size() > 0)
+	std::span<const GlyphPoint> points = GetGlyph(character);
+	if (points.empty())
 	{
-		for (int i = 0; i + 1 < points.size(); i += 2)
-		{
-			DrawLineSegment(points[i] * size + pos, points[i + 1] * size + pos, colour);
-		}
-		return size;
+		return character == ' ' ? size : 0.0f;
 	}
-	else
+
+	if (view.IsSmallerThan(size, MinLegibleTextPixels) || !view.Overlaps(pos, pos + Vec2(size, size * 1.6f))) return size;
+
+	//The whole glyph's on screen (or near enough), so it goes straight in without checking every segment.
+	const uint32_t packed = colour.Pack();
+	for (const GlyphPoint& point : points)
 	{
-		if (character == ' ') return size;
-		else return 0.0f;
+		vertices.Push(LineVertex{ { point.x * size + pos.x, point.y * size + pos.y }, packed });
 	}
+	return size;
 }
 
-std::vector<Vec2> LineRenderer::GetGlyph(char character)
+float LineRenderer::GetTextWidth(std::string_view text, float size)
 {
-	switch (character)
+	float width = 0.0f;
+	for (char character : text)
 	{
-	case 'a':
-	case 'A':
-		return { {0.2f, 0.2f}, {0.5f, 1.6f}, {0.5f, 1.6f}, {0.8f, 0.2f} , {0.3f, 0.8f}, {0.7f, 0.8f} };
-	case 'b':
-	case 'B':
-		return { {0.2f, 0.2f}, {0.2f, 1.6f}, {0.2f, 1.6f}, {0.6f, 1.6f}, {0.8f, 1.3f}, {0.6f, 1.6f}, {0.8f, 1.3f}, {0.6f, 1.0f}, {0.6f, 1.0f}, {0.2f, 1.0f}, {0.6f, 1.0f}, {0.9f, 0.6f}, {0.9f, 0.6f}, {0.7f, 0.2f}, {0.7f, 0.2f}, {0.2f, 0.2f} };
-	case 'c':
-	case 'C':
-		return { {0.8f, 1.4f}, {0.6f, 1.6f}, {0.3f, 1.6f}, {0.1f, 1.3f}, {0.1f, 1.3f}, {0.1f, 0.5f}, {0.1f, 0.5f}, {0.3f, 0.2f}, {0.6f, 0.2f}, {0.8f, 0.4f}, {0.3f, 0.2f}, {0.6f, 0.2f}, {0.3f, 1.6f}, {0.6f, 1.6f} };
-	case 'd':
-	case 'D':
-		return { {0.2f, 1.6f}, {0.5f, 1.6f}, {0.8f, 1.3f}, {0.5f, 1.6f}, {0.8f, 1.3f}, {0.8f, 0.5f}, {0.8f, 0.5f}, {0.5f, 0.2f}, {0.5f, 0.2f}, {0.2f, 0.2f}, {0.2f, 0.2f}, {0.2f, 1.6f} };
-	case 'e':
-	case 'E':
-		return { {0.8f, 1.6f}, {0.2f, 1.6f}, {0.2f, 1.6f}, {0.2f, 0.2f}, {0.2f, 0.2f}, {0.8f, 0.2f}, {0.7f, 0.9f}, {0.2f, 0.9f} };
-	case 'f':
-	case 'F':
-		return { {0.8f, 1.6f}, {0.2f, 1.6f}, {0.2f, 1.6f}, {0.2f, 0.2f}, {0.7f, 0.9f}, {0.2f, 0.9f} };
-	case 'g':
-	case 'G':
-		return { {0.8f, 1.3f}, {0.6f, 1.5f}, {0.6f, 1.5f}, {0.3f, 1.5f}, {0.3f, 1.5f}, {0.1f, 1.1f}, {0.1f, 1.1f}, {0.1f, 0.6f}, {0.1f, 0.6f}, {0.2f, 0.3f}, {0.2f, 0.3f}, {0.5f, 0.2f}, {0.8f, 0.5f}, {0.5f, 0.2f}, {0.8f, 0.2f}, {0.8f, 0.5f}, {0.5f, 0.5f}, {0.8f, 0.5f} };
-	case 'h':
-	case 'H':
-		return { {0.2f, 1.5f}, {0.2f, 0.2f}, {0.8f, 1.5f}, {0.8f, 0.2f}, {0.2f, 0.9f}, {0.8f, 0.9f} };
-	case 'i':
-	case 'I':
-		return { {0.5f, 1.5f}, {0.5f, 0.2f}, {0.4f, 1.5f}, {0.6f, 1.5f}, {0.4f, 0.2f}, {0.6f, 0.2f} };
-	case 'j':
-	case 'J':
-		return { {0.7f, 1.5f}, {0.8f, 0.5f}, {0.4f, 1.5f}, {0.8f, 1.5f}, {0.6f, 0.2f}, {0.3f, 0.2f}, {0.2f, 0.5f}, {0.3f, 0.2f}, {0.8f, 0.5f}, {0.6f, 0.2f} };
-	case 'k':
-	case 'K':
-		return { {0.2f, 1.5f}, {0.2f, 0.2f}, {0.8f, 1.4f}, {0.2f, 0.8f}, {0.8f, 0.2f}, {0.3f, 0.9f} };
-	case 'l':
-	case 'L':
-		return { {0.2f, 1.5f}, {0.2f, 0.2f}, {0.8f, 0.2f}, {0.2f, 0.2f} };
-	case 'm':
-	case 'M':
-		return { {0.2f, 1.4f}, {0.2f, 0.2f}, {0.8f, 1.4f}, {0.8f, 0.2f}, {0.5f, 0.8f}, {0.8f, 1.4f}, {0.2f, 1.4f}, {0.5f, 0.8f} };
-	case 'n':
-	case 'N':
-		return { {0.2f, 1.4f}, {0.2f, 0.2f}, {0.8f, 0.2f}, {0.8f, 1.4f}, {0.2f, 1.4f}, {0.8f, 0.2f} };
-	case 'o':
-	case 'O':
-		return { {0.5f, 1.5f}, {0.2f, 1.2f}, {0.8f, 1.2f}, {0.5f, 1.5f}, {0.5f, 0.1f}, {0.8f, 0.4f}, {0.2f, 0.4f}, {0.5f, 0.1f}, {0.2f, 0.4f}, {0.2f, 1.2f}, {0.8f, 0.4f}, {0.8f, 1.2f} };
-	case 'p':
-	case 'P':
-		return { {0.2f, 1.6f}, {0.6f, 1.6f}, {0.8f, 1.3f}, {0.6f, 1.6f}, {0.6f, 0.9f}, {0.8f, 1.3f}, {0.2f, 0.9f}, {0.6f, 0.9f}, {0.2f, 1.6f}, {0.2f, 0.2f} };
-	case 'q':
-	case 'Q':
-		return { {0.5f, 1.6f}, {0.1f, 1.2f}, {0.1f, 0.5f}, {0.4f, 0.2f}, {0.9f, 0.5f}, {0.9f, 1.2f}, {0.5f, 1.6f}, {0.9f, 1.2f}, {0.1f, 1.2f}, {0.1f, 0.5f}, {0.4f, 0.2f}, {0.9f, 0.5f}, {0.5f, 0.5f}, {0.8f, 0.2f} };
-	case 'r':
-	case 'R':
-		return { {0.2f, 1.6f}, {0.7f, 1.6f}, {0.9f, 1.2f}, {0.7f, 0.9f}, {0.2f, 0.9f}, {0.7f, 0.9f}, {0.7f, 1.6f}, {0.9f, 1.2f}, {0.4f, 0.9f}, {0.8f, 0.2f}, {0.2f, 0.2f}, {0.2f, 1.6f} };
-	case 's':
-	case 'S':
-		return { {0.9f, 1.3f}, {0.7f, 1.6f}, {0.3f, 1.6f}, {0.1f, 1.3f}, {0.2f, 0.9f}, {0.8f, 0.7f}, {0.9f, 0.3f}, {0.5f, 0.1f}, {0.1f, 0.3f}, {0.5f, 0.1f}, {0.8f, 0.7f}, {0.9f, 0.3f}, {0.7f, 1.6f}, {0.3f, 1.6f}, {0.1f, 1.3f}, {0.2f, 0.9f} };
-	case 't':
-	case 'T':
-		return { {0.1f, 1.5f}, {0.9f, 1.5f}, {0.5f, 1.5f}, {0.5f, 0.2f} };
-	case 'u':
-	case 'U':
-		return { {0.8f, 1.5f}, {0.8f, 0.6f}, {0.4f, 0.2f}, {0.2f, 0.6f}, {0.2f, 1.5f}, {0.2f, 0.6f}, {0.8f, 0.6f}, {0.6f, 0.2f}, {0.4f, 0.2f}, {0.6f, 0.2f} };
-	case 'v':
-	case 'V':
-		return { {0.9f, 1.5f}, {0.5f, 0.2f}, {0.5f, 0.2f}, {0.1f, 1.5f} };
-	case 'w':
-	case 'W':
-		return { {0.9f, 1.5f}, {0.8f, 0.2f}, {0.2f, 0.2f}, {0.1f, 1.5f}, {0.5f, 0.8f}, {0.8f, 0.2f}, {0.5f, 0.8f}, {0.2f, 0.2f} };
-	case 'x':
-	case 'X':
-		return { {0.8f, 0.2f}, {0.2f, 1.5f}, {0.2f, 0.2f}, {0.8f, 1.5f} };
-	case 'y':
-	case 'Y':
-		return { {0.2f, 1.5f}, {0.5f, 0.9f}, {0.8f, 1.5f}, {0.5f, 0.9f}, {0.5f, 0.2f}, {0.5f, 0.9f} };
-	case 'z':
-	case 'Z':
-		return { {0.2f, 1.5f}, {0.8f, 1.5f}, {0.8f, 0.2f}, {0.2f, 0.2f}, {0.8f, 1.5f}, {0.2f, 0.2f} };
-	case '1':
-		return { {0.3f, 1.3f}, {0.5f, 1.4f}, {0.5f, 1.4f}, {0.5f, 0.2f}, {0.3f, 0.2f}, {0.7f, 0.2f} };
-	case '2':
-		return { {0.2f, 1.3f}, {0.4f, 1.5f}, {0.6f, 0.8f}, {0.7f, 1.3f}, {0.2f, 0.3f}, {0.6f, 0.8f}, {0.8f, 0.3f}, {0.2f, 0.3f}, {0.4f, 1.5f}, {0.7f, 1.3f} };
-	case '3':
-		return { {0.2f, 1.3f}, {0.5f, 1.5f}, {0.4f, 0.9f}, {0.8f, 1.2f}, {0.5f, 1.5f}, {0.8f, 1.2f}, {0.7f, 0.7f}, {0.4f, 0.9f}, {0.8f, 0.4f}, {0.7f, 0.7f}, {0.2f, 0.3f}, {0.4f, 0.2f}, {0.8f, 0.4f}, {0.4f, 0.2f} };
-	case '4':
-		return { {0.6f, 1.5f}, {0.2f, 0.8f}, {0.8f, 0.8f}, {0.2f, 0.8f}, {0.6f, 0.9f}, {0.5f, 0.2f} };
-	case '5':
-		return { {0.8f, 1.4f}, {0.2f, 1.4f}, {0.2f, 0.9f}, {0.6f, 0.8f}, {0.8f, 0.5f}, {0.6f, 0.2f}, {0.6f, 0.8f}, {0.8f, 0.5f}, {0.2f, 1.4f}, {0.2f, 0.9f}, {0.1f, 0.3f}, {0.6f, 0.2f} };
-	case '6':
-		return { {0.7f, 1.5f}, {0.3f, 1.2f}, {0.2f, 0.8f}, {0.2f, 0.4f}, {0.5f, 0.2f}, {0.8f, 0.4f}, {0.9f, 0.7f}, {0.6f, 0.9f}, {0.8f, 0.4f}, {0.9f, 0.7f}, {0.2f, 0.4f}, {0.5f, 0.2f}, {0.3f, 1.2f}, {0.2f, 0.8f}, {0.2f, 0.8f}, {0.6f, 0.9f} };
-	case '7':
-		return { {0.2f, 1.4f}, {0.8f, 1.4f}, {0.5f, 0.8f}, {0.4f, 0.2f}, {0.5f, 0.8f}, {0.8f, 1.4f} };
-	case '8':
-		return { {0.5f, 1.5f}, {0.3f, 1.3f}, {0.3f, 1.f}, {0.8f, 0.6f}, {0.8f, 0.3f}, {0.5f, 0.1f}, {0.2f, 0.3f}, {0.5f, 0.1f}, {0.2f, 0.6f}, {0.2f, 0.3f}, {0.8f, 0.6f}, {0.8f, 0.3f}, {0.7f, 1.3f}, {0.7f, 1.f}, {0.2f, 0.6f}, {0.7f, 1.f}, {0.5f, 1.5f}, {0.7f, 1.3f}, {0.3f, 1.3f}, {0.3f, 1.f} };
-	case '9':
-		return { {0.2f, 1.3f}, {0.4f, 1.5f}, {0.7f, 1.5f}, {0.8f, 1.1f}, {0.7f, 0.6f}, {0.2f, 0.2f}, {0.2f, 1.f}, {0.5f, 0.9f}, {0.8f, 1.1f}, {0.5f, 0.9f}, {0.8f, 1.1f}, {0.7f, 0.6f}, {0.2f, 1.3f}, {0.2f, 1.f}, {0.4f, 1.5f}, {0.7f, 1.5f} };
-	case '0':
-		return { {0.5f, 1.5f}, {0.2f, 1.1f}, {0.2f, 0.5f}, {0.5f, 0.2f}, {0.8f, 0.5f}, {0.8f, 1.1f}, {0.5f, 1.5f}, {0.8f, 1.1f}, {0.2f, 1.1f}, {0.2f, 0.5f}, {0.8f, 0.5f}, {0.5f, 0.2f}, {0.2f, 0.2f}, {0.8f, 1.5f} };
-	case '!':
-		return { {0.5f, 1.5f}, {0.5f, 0.6f}, {0.4f, 0.3f}, {0.6f, 0.1f}, {0.6f, 0.3f}, {0.4f, 0.1f} };
-	case '"':
-		return { {0.4f, 1.4f}, {0.4f, 1.2f}, {0.6f, 1.4f}, {0.6f, 1.2f} };
-	case '#':
-		return { {0.3f, 1.3f}, {0.3f, 0.6f}, {0.7f, 1.3f}, {0.7f, 0.6f}, {0.1f, 1.1f}, {0.9f, 1.1f}, {0.1f, 0.8f}, {0.9f, 0.8f} };
-	case '$':
-		return { {0.5f, 1.5f}, {0.8f, 1.3f}, {0.2f, 1.2f}, {0.2f, 0.9f}, {0.8f, 0.7f}, {0.8f, 0.4f}, {0.5f, 0.2f}, {0.2f, 0.4f}, {0.5f, 0.2f}, {0.8f, 0.4f}, {0.2f, 0.9f}, {0.8f, 0.7f}, {0.5f, 1.5f}, {0.2f, 1.2f}, {0.4f, 1.5f}, {0.4f, 0.2f}, {0.6f, 1.5f}, {0.6f, 0.2f} };
-	case '%':
-		return { {0.8f, 1.4f}, {0.2f, 0.3f}, {0.3f, 1.1f}, {0.2f, 1.0f}, {0.3f, 0.9f}, {0.4f, 1.0f}, {0.2f, 1.0f}, {0.3f, 0.9f}, {0.3f, 1.1f}, {0.4f, 1.0f}, {0.6f, 0.7f}, {0.7f, 0.8f}, {0.7f, 0.6f}, {0.8f, 0.7f}, {0.6f, 0.7f}, {0.7f, 0.6f}, {0.7f, 0.8f}, {0.8f, 0.7f} };
-	case '&':
-		return { {0.5f, 1.5f}, {0.2f, 1.3f}, {0.2f, 1.f}, {0.6f, 0.7f}, {0.9f, 0.5f}, {0.4f, 0.2f}, {0.2f, 0.4f}, {0.4f, 0.2f}, {0.2f, 0.6f}, {0.2f, 0.4f}, {0.6f, 0.7f}, {0.8f, 0.2f}, {0.2f, 0.6f}, {0.7f, 1.f}, {0.5f, 1.5f}, {0.7f, 1.3f}, {0.2f, 1.3f}, {0.2f, 1.f} };
-	case '\'':
-		return { {0.5f, 1.4f}, {0.5f, 1.2f} };
-	case '(':
-		return { {0.5f, 1.5f}, {0.2f, 1.1f}, {0.2f, 0.6f}, {0.5f, 0.2f}, {0.2f, 1.1f}, {0.2f, 0.6f} };
-	case ')':
-		return { {0.5f, 1.5f}, {0.8f, 1.1f}, {0.8f, 0.6f}, {0.5f, 0.2f}, {0.8f, 1.1f}, {0.8f, 0.6f} };
-	case '*':
-		return { {0.4f, 1.4f}, {0.6f, 1.0f}, {0.6f, 1.4f}, {0.4f, 1.0f}, {0.3f, 1.2f}, {0.7f, 1.2f} };
-	case '+':
-		return { {0.5f, 1.1f}, {0.5f, 0.5f}, {0.2f, 0.8f}, {0.8f, 0.8f} };
-	case ',':
-		return { {0.6f, 0.4f}, {0.4f, 0.2f} };
-	case '-':
-		return { {0.2f, 0.9f}, {0.8f, 0.9f} };
-	case '.':
-		return { {0.4f, 0.3f}, {0.6f, 0.3f}, {0.5f, 0.4f}, {0.5f, 0.2f} };
-	case '/':
-		return { {0.8f, 1.4f}, {0.2f, 0.2f} };
-	case ':':
-		return { {0.6f, 1.3f}, {0.5f, 1.2f}, {0.4f, 1.3f}, {0.5f, 1.4f}, {0.5f, 1.4f}, {0.6f, 1.3f}, {0.4f, 1.3f}, {0.5f, 1.2f}, {0.5f, 0.5f}, {0.4f, 0.4f}, {0.5f, 0.3f}, {0.6f, 0.4f}, {0.5f, 0.5f}, {0.6f, 0.4f}, {0.4f, 0.4f}, {0.5f, 0.3f} };
-	case ';':
-		return { {0.6f, 1.3f}, {0.5f, 1.2f}, {0.4f, 1.3f}, {0.5f, 1.4f}, {0.5f, 1.4f}, {0.6f, 1.3f}, {0.4f, 1.3f}, {0.5f, 1.2f}, {0.6f, 0.5f}, {0.4f, 0.2f} };
-	case '<':
-		return { {0.8f, 1.2f}, {0.1f, 0.9f}, {0.8f, 0.6f}, {0.1f, 0.9f} };
-	case '=':
-		return { {0.8f, 1.2f}, {0.2f, 1.2f}, {0.8f, 0.6f}, {0.2f, 0.6f} };
-	case '>':
-		return { {0.9f, 0.9f}, {0.2f, 1.2f}, {0.9f, 0.9f}, {0.2f, 0.6f} };
-	case '?':
-		return { {0.1f, 1.2f}, {0.3f, 1.5f}, {0.7f, 1.5f}, {0.9f, 1.3f}, {0.3f, 1.5f}, {0.7f, 1.5f}, {0.8f, 1.0f}, {0.9f, 1.3f}, {0.5f, 0.8f}, {0.8f, 1.0f}, {0.5f, 0.5f}, {0.5f, 0.8f}, {0.5f, 0.3f}, {0.4f, 0.2f}, {0.6f, 0.2f}, {0.5f, 0.1f}, {0.6f, 0.2f}, {0.5f, 0.3f}, {0.4f, 0.2f}, {0.5f, 0.1f} };
-	case '@':
-		return { {0.8f, 1.0f}, {0.5f, 1.2f}, {0.3f, 1.0f}, {0.3f, 0.6f}, {0.5f, 0.5f}, {0.8f, 0.7f}, {0.7f, 1.5f}, {0.8f, 0.7f}, {0.5f, 1.2f}, {0.3f, 1.0f}, {0.5f, 0.5f}, {0.3f, 0.6f}, {0.4f, 1.5f}, {0.7f, 1.5f}, {0.1f, 1.1f}, {0.4f, 1.5f}, {0.1f, 0.5f}, {0.1f, 1.1f}, {0.4f, 0.2f}, {0.8f, 0.3f}, {0.1f, 0.5f}, {0.4f, 0.2f} };
-	case '[':
-		return { {0.5f, 1.5f}, {0.2f, 1.5f}, {0.2f, 0.2f}, {0.5f, 0.2f}, {0.2f, 0.2f}, {0.2f, 1.5f} };
-	case ']':
-		return { {0.5f, 1.5f}, {0.8f, 1.5f}, {0.8f, 0.2f}, {0.5f, 0.2f}, {0.8f, 0.2f}, {0.8f, 1.5f} };
-	case '\\':
-		return { {0.2f, 1.5f}, {0.8f, 0.2f} };
-	case '^':
-		return { {0.5f, 1.5f}, {0.3f, 1.2f}, {0.7f, 1.2f}, {0.5f, 1.5f} };
-	case '_':
-		return { {0.2f, 0.2f}, {0.8f, 0.2f} };
-	case '`':
-		return { {0.4f, 1.4f}, {0.6f, 1.2f} };
-	case '{':
-		return { {0.5f, 0.2f}, {0.3f, 0.3f}, {0.2f, 0.9f}, {0.3f, 0.7f}, {0.3f, 0.7f}, {0.3f, 0.3f}, {0.3f, 1.0f}, {0.3f, 1.3f}, {0.3f, 1.3f}, {0.5f, 1.4f}, {0.3f, 1.0f}, {0.2f, 0.8f} };
-	case '}':
-		return { {0.5f, 0.2f}, {0.7f, 0.3f}, {0.8f, 0.9f}, {0.7f, 0.7f}, {0.7f, 0.7f}, {0.7f, 0.3f}, {0.7f, 1.0f}, {0.7f, 1.3f}, {0.7f, 1.3f}, {0.5f, 1.4f}, {0.7f, 1.0f}, {0.8f, 0.8f} };
-	case '|':
-		return { {0.5f, 0.2f}, {0.5f, 1.4f} };
-	case '~':
-		return { {0.1f, 0.9f}, {0.3f, 1.1f}, {0.7f, 0.9f}, {0.9f, 1.1f}, {0.3f, 1.1f}, {0.7f, 0.9f} };
+		if (character == ' ' || !GetGlyph(character).empty()) width += size;
 	}
-	return {};
+	return width;
+}
+
+std::span<const GlyphPoint> LineRenderer::GetGlyph(char character)
+{
+	const unsigned char index = (unsigned char)character;
+	if (index >= GlyphTable.size()) return {};
+
+	const GlyphRange range = GlyphTable[index];
+	return { GlyphPoints + range.offset, range.count };
 }
 
 int LineRenderer::GetCircleSegmentCount(float radius) const
 {
-	return Clamp((int)(sqrtf(radius * cameraZoomFactor) * 32 + 4), 5, 128);
+	return Clamp((int)(sqrtf(radius * view.zoomFactor) * 32 + 4), 5, 128);
 }
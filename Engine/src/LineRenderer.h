@@ -4,17 +4,25 @@
 #include <vector>
 #include "Graphics.h"
 #include "Colour.h"
+#include "StreamBuffer.h"
+#include "ViewBounds.h"
+#include "Glyphs.h"
+#include "CachedText.h"
+#include <span>
+#include <string_view>
 #include <string>
 
-#ifdef linux
-#include <cfloat>
-#endif
+//What actually goes to the GPU. The colour is packed down to RGBA8, so it's 12 bytes a vertex instead of 20.
+struct LineVertex
+{
+	Vec2 position;
+	uint32_t colour;
+};
+static_assert(sizeof(LineVertex) == 12);
 
 class LineRenderer
 {
 private:
-	std::vector<Vec2> positions;
-	std::vector<Colour> colours;
 	bool initialised = false;
 
 	Colour currentColour = { 1.0f,1.0f,1.0f };
@@ -25,14 +33,15 @@ private:
 	Colour lastColour = { 0.0f,0.0f,0.0f };
 	bool lineActive = false;
 
-	GLuint positionBufferID = 0;
-	GLuint colourBufferID = 0;
+	//Set up once in Initialise().
+	GLuint vertexArrayID = 0;
 
-	float cameraXMin = -FLT_MAX;
-	float cameraXMax = FLT_MAX;
-	float cameraYMin = -FLT_MAX;
-	float cameraYMax = FLT_MAX;
-	float cameraZoomFactor = 1.0f;
+	//Lines get written straight into this, no copying.
+	StreamBuffer vertices;
+	int compiledCount = 0;
+
+	//Anything entirely outside this doesn't get drawn at all.
+	ViewBounds view;
 
 public:
 	LineRenderer() = default;
@@ -65,8 +74,12 @@ public:
 	void DrawCircleArc(Vec2 centre, float size, float startBearing, float endBearing, int fullSegmentCount = 64);
 	void DrawCircleArc(Vec2 centre, float size, float startBearing, float endBearing, Colour colour, int fullSegmentCount = 64);
 
-	float DrawText(std::string text, Vec2 pos, float size);
-	float DrawText(std::string text, Vec2 pos, float size, Colour colour);
+	//These all return how far along the text went, so the next thing can be drawn after it.
+	float DrawText(std::string_view text, Vec2 pos, float size);
+	float DrawText(std::string_view text, Vec2 pos, float size, Colour colour);
+	//Same again, but for text that was laid out ahead of time.
+	float DrawText(const CachedText& text, Vec2 pos, float size);
+	float DrawText(const CachedText& text, Vec2 pos, float size, Colour colour);
 	float DrawChar(char character, Vec2 pos, float size);
 	float DrawChar(char character, Vec2 pos, float size, Colour colour);
 
@@ -74,11 +87,16 @@ public:
 	void Compile();
 	void Draw();
 
-	void UpdateWithCameraInfo(Vec2 pos, float height, float aspect);
+	//viewportPixelHeight is what the level of detail is worked out from. Without it, nothing gets simplified.
+	void UpdateWithCameraInfo(Vec2 pos, float height, float aspect, int viewportPixelHeight = 0);
+
+	//Empty for characters there's no glyph for.
+	static std::span<const GlyphPoint> GetGlyph(char character);
+	static float GetTextWidth(std::string_view text, float size);
 
 
 private:
-	static std::vector<Vec2> GetGlyph(char character);
+	void AddVertex(Vec2 position, Colour colour) { vertices.Push(LineVertex{ position, colour.Pack() }); }
 
 	int GetCircleSegmentCount(float radius) const;
 
@@ -0,0 +1,281 @@
+#include "Profiler.h"
+
+#ifdef ENGINE_PROFILER
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+
+//Events per thread. Anything that doesn't fit before the next EndFrame() gets dropped (a whole zone at a time).
+constexpr uint64_t RingCapacity = 1 << 16;
+
+struct ProfileEvent
+{
+	const char* name;
+	uint64_t time;
+	bool begin;
+};
+
+//One per thread that has ever recorded a zone. The owning thread is the only writer and EndFrame() is the only reader, so the
+//two positions are all that need to be atomic.
+struct ThreadBuffer
+{
+	int id = 0;
+	std::string name;
+	std::unique_ptr<ProfileEvent[]> events = std::make_unique<ProfileEvent[]>(RingCapacity);
+	std::atomic<uint64_t> written = 0;
+	std::atomic<uint64_t> read = 0;
+	std::atomic<bool> finished = false;
+
+	//Writer side. How many zones have been started but not ended, since their ends need to be guaranteed a slot.
+	int openZones = 0;
+
+	//Reader side. Zones that have started but not finished yet, which may carry over into the next frame.
+	std::vector<ProfileZone> openStack;
+};
+
+//Flags the buffer once its thread exits, so EndFrame() can throw it away after emptying it.
+struct ThreadBufferHandle
+{
+	ThreadBuffer* buffer = nullptr;
+	~ThreadBufferHandle()
+	{
+		if (buffer) buffer->finished.store(true, std::memory_order_release);
+	}
+};
+
+std::atomic<bool> Profiler::enabled = false;
+
+static std::mutex registryMutex;
+static std::vector<std::unique_ptr<ThreadBuffer>> threadBuffers;
+static int threadsRegistered = 0;
+static ProfileFrame lastFrame;
+static thread_local ThreadBufferHandle threadBuffer;
+static thread_local std::string threadName;
+
+//Where a capture is being written to, as a trace event file (one JSON object per zone).
+struct Capture
+{
+	std::ofstream file;
+	bool active = false;
+	bool wasEnabled = false;
+	bool firstEvent = true;
+	uint64_t start = 0;
+	std::vector<int> namedThreads;
+};
+
+static Capture capture;
+
+//The buffer only gets made the first time the thread records something, so threads that never do don't cost anything.
+static ThreadBuffer& GetThreadBuffer()
+{
+	if (!threadBuffer.buffer)
+	{
+		std::lock_guard<std::mutex> lock(registryMutex);
+		threadBuffers.push_back(std::make_unique<ThreadBuffer>());
+		threadBuffer.buffer = threadBuffers.back().get();
+		threadBuffer.buffer->id = threadsRegistered;
+		threadBuffer.buffer->name = threadName.empty() ? "Thread " + std::to_string(threadsRegistered) : threadName;
+		threadsRegistered++;
+	}
+	return *threadBuffer.buffer;
+}
+
+void Profiler::SetEnabled(bool enable)
+{
+	enabled.store(enable, std::memory_order_relaxed);
+}
+
+bool Profiler::IsEnabled()
+{
+	return enabled.load(std::memory_order_relaxed);
+}
+
+void Profiler::SetThreadName(const char* name)
+{
+	threadName = name;
+
+	if (threadBuffer.buffer)
+	{
+		std::lock_guard<std::mutex> lock(registryMutex);
+		threadBuffer.buffer->name = name;
+	}
+}
+
+uint64_t Profiler::Now()
+{
+	return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool Profiler::BeginZone(const char* name)
+{
+	if (!enabled.load(std::memory_order_relaxed)) return false;
+
+	ThreadBuffer& buffer = GetThreadBuffer();
+	const uint64_t written = buffer.written.load(std::memory_order_relaxed);
+	const uint64_t used = written - buffer.read.load(std::memory_order_acquire);
+
+	//Room for this event, its end, and the ends of everything already open.
+	if (used + buffer.openZones + 2 > RingCapacity) return false;
+
+	buffer.events[written % RingCapacity] = { name, Now(), true };
+	buffer.written.store(written + 1, std::memory_order_release);
+	buffer.openZones++;
+	return true;
+}
+
+void Profiler::EndZone()
+{
+	ThreadBuffer& buffer = GetThreadBuffer();
+	const uint64_t written = buffer.written.load(std::memory_order_relaxed);
+
+	buffer.events[written % RingCapacity] = { nullptr, Now(), false };
+	buffer.written.store(written + 1, std::memory_order_release);
+	buffer.openZones--;
+}
+
+//Zone and thread names only need quotes and backslashes escaped to be valid JSON.
+static void WriteEscaped(std::ofstream& file, const char* text)
+{
+	for (const char* c = text; *c; c++)
+	{
+		if (*c == '"' || *c == '\\') file << '\\';
+		file << *c;
+	}
+}
+
+static void WriteCaptureSeparator()
+{
+	if (!capture.firstEvent) capture.file << ",\n";
+	capture.firstEvent = false;
+}
+
+static void WriteCapture(const ProfileThread& thread)
+{
+	if (thread.zones.empty()) return;
+
+	//Names the thread's row the first time it shows up.
+	if (std::find(capture.namedThreads.begin(), capture.namedThreads.end(), thread.id) == capture.namedThreads.end())
+	{
+		capture.namedThreads.push_back(thread.id);
+		WriteCaptureSeparator();
+		capture.file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << thread.id << ",\"args\":{\"name\":\"";
+		WriteEscaped(capture.file, thread.name.c_str());
+		capture.file << "\"}}";
+	}
+
+	//Complete events, in microseconds since the capture started. Anything already running when it started gets cut off there.
+	for (const ProfileZone& zone : thread.zones)
+	{
+		const uint64_t start = (zone.start > capture.start) ? zone.start : capture.start;
+		const uint64_t end = (zone.end > start) ? zone.end : start;
+
+		WriteCaptureSeparator();
+		capture.file << "{\"name\":\"";
+		WriteEscaped(capture.file, zone.name);
+		capture.file << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << thread.id
+			<< ",\"ts\":" << (start - capture.start) / 1000.0 << ",\"dur\":" << (end - start) / 1000.0 << "}";
+	}
+}
+
+void Profiler::EndFrame()
+{
+	std::lock_guard<std::mutex> lock(registryMutex);
+
+	lastFrame.start = lastFrame.end;
+	lastFrame.end = Now();
+	if (lastFrame.start == 0) lastFrame.start = lastFrame.end;
+	lastFrame.threads.clear();
+
+	for (size_t i = 0; i < threadBuffers.size(); )
+	{
+		ThreadBuffer& buffer = *threadBuffers[i];
+
+		//Checked before reading, so nothing the thread wrote on its way out gets missed.
+		const bool finished = buffer.finished.load(std::memory_order_acquire);
+		const uint64_t written = buffer.written.load(std::memory_order_acquire);
+		uint64_t read = buffer.read.load(std::memory_order_relaxed);
+
+		ProfileThread thread;
+		thread.id = buffer.id;
+		thread.name = buffer.name;
+
+		for (; read < written; read++)
+		{
+			const ProfileEvent& event = buffer.events[read % RingCapacity];
+			if (event.begin)
+			{
+				buffer.openStack.push_back({ event.name, event.time, 0, (int)buffer.openStack.size() });
+			}
+			else if (!buffer.openStack.empty())
+			{
+				ProfileZone zone = buffer.openStack.back();
+				buffer.openStack.pop_back();
+				zone.end = event.time;
+				thread.zones.push_back(zone);
+			}
+		}
+		buffer.read.store(read, std::memory_order_release);
+
+		if (capture.active) WriteCapture(thread);
+		if (!thread.zones.empty()) lastFrame.threads.push_back(std::move(thread));
+
+		if (finished)
+		{
+			threadBuffers.erase(threadBuffers.begin() + i);
+		}
+		else
+		{
+			i++;
+		}
+	}
+}
+
+const ProfileFrame& Profiler::GetLastFrame()
+{
+	return lastFrame;
+}
+
+bool Profiler::StartCapture(const char* path)
+{
+	std::lock_guard<std::mutex> lock(registryMutex);
+	if (capture.active) return true;
+
+	capture.file.open(path, std::ios::out | std::ios::trunc);
+	if (!capture.file.is_open()) return false;
+
+	capture.file.setf(std::ios::fixed);
+	capture.file.precision(3);
+	capture.file << "{\"traceEvents\":[\n";
+
+	capture.active = true;
+	capture.firstEvent = true;
+	capture.start = Now();
+	capture.namedThreads.clear();
+	capture.wasEnabled = IsEnabled();
+	SetEnabled(true);
+	return true;
+}
+
+void Profiler::StopCapture()
+{
+	//Picks up whatever finished since the last frame.
+	EndFrame();
+
+	std::lock_guard<std::mutex> lock(registryMutex);
+	if (!capture.active) return;
+
+	capture.file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+	capture.file.close();
+	capture.active = false;
+	SetEnabled(capture.wasEnabled);
+}
+
+bool Profiler::IsCapturing()
+{
+	std::lock_guard<std::mutex> lock(registryMutex);
+	return capture.active;
+}
+
+#endif
@@ -0,0 +1,104 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//A scoped-zone profiler. Put PROFILE_ZONE("Name") at the top of a scope and the time spent in it gets recorded, on whichever thread
+//it runs on. Every thread writes into its own ring buffer, so recording a zone never takes a lock. Once a frame the main thread calls
+//Profiler::EndFrame(), which collects everything that finished since the last frame from every thread.
+//
+//Zone names have to outlive the profiler (string literals, basically), since only the pointer gets stored.
+//
+//A capture streams every zone from every thread into a trace event JSON file as it's collected, which can be opened in
+//chrome://tracing or ui.perfetto.dev.
+//
+//Unless ENGINE_PROFILER is defined, PROFILE_ZONE and the rest of the profiler compile to nothing. Even when it is, nothing gets recorded until recording is
+//turned on with SetEnabled().
+
+//A zone that finished during the frame. Times are in nanoseconds on the steady clock.
+struct ProfileZone
+{
+	const char* name;
+	uint64_t start;
+	uint64_t end;
+	int depth;
+};
+
+struct ProfileThread
+{
+	int id;
+	std::string name;
+	std::vector<ProfileZone> zones;
+};
+
+struct ProfileFrame
+{
+	uint64_t start = 0;
+	uint64_t end = 0;
+	std::vector<ProfileThread> threads;
+};
+
+class Profiler
+{
+public:
+#ifdef ENGINE_PROFILER
+	static void SetEnabled(bool enable);
+	static bool IsEnabled();
+
+	//Shows up in the profiler instead of "Thread N".
+	static void SetThreadName(const char* name);
+
+	//Collects every zone that finished since the last call. Call it once a frame, from one thread.
+	static void EndFrame();
+	static const ProfileFrame& GetLastFrame();
+
+	//Starts recording (if it wasn't already) and writes everything collected by EndFrame() to the file until StopCapture().
+	//Returns false if the file couldn't be opened.
+	static bool StartCapture(const char* path);
+	static void StopCapture();
+	static bool IsCapturing();
+
+	//Used by PROFILE_ZONE. BeginZone returns whether anything was recorded, so the end only gets recorded if the start was.
+	static bool BeginZone(const char* name);
+	static void EndZone();
+
+	static uint64_t Now();
+
+private:
+	static std::atomic<bool> enabled;
+#else
+	//Without ENGINE_PROFILER none of Profiler.cpp gets compiled, so everything here does nothing and never records or captures.
+	static void SetEnabled(bool) {}
+	static bool IsEnabled() { return false; }
+	static void SetThreadName(const char*) {}
+	static void EndFrame() {}
+	static const ProfileFrame& GetLastFrame() { static const ProfileFrame empty; return empty; }
+	static bool StartCapture(const char*) { return false; }
+	static void StopCapture() {}
+	static bool IsCapturing() { return false; }
+	static bool BeginZone(const char*) { return false; }
+	static void EndZone() {}
+	static uint64_t Now() { return 0; }
+#endif
+};
+
+class ProfileScope
+{
+public:
+	explicit ProfileScope(const char* name) : recording(Profiler::BeginZone(name)) {}
+	~ProfileScope() { if (recording) Profiler::EndZone(); }
+	ProfileScope(const ProfileScope& other) = delete;
+	ProfileScope& operator=(const ProfileScope& other) = delete;
+
+private:
+	bool recording;
+};
+
+#ifdef ENGINE_PROFILER
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_ZONE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#else
+#define PROFILE_ZONE(name)
+#endif
@@ -140,3 +140,15 @@ void ShaderProgram::SetMat4Uniform(std::string varName, float* matrix)
 	GLuint varLoc = glGetUniformLocation(shaderProgram, varName.c_str());
 	glUniformMatrix4fv(varLoc, 1, GL_FALSE, matrix);
 }
+
+void ShaderProgram::SetFloatUniform(std::string varName, float value)
+{
+	GLuint varLoc = glGetUniformLocation(shaderProgram, varName.c_str());
+	glUniform1f(varLoc, value);
+}
+
+void ShaderProgram::SetIntUniform(std::string varName, int value)
+{
+	GLuint varLoc = glGetUniformLocation(shaderProgram, varName.c_str());
+	glUniform1i(varLoc, value);
+}
@@ -34,4 +34,6 @@ public:
 	void UseShader();
 
 	void SetMat4Uniform(std::string varName, float* matrix);
+	void SetFloatUniform(std::string varName, float value);
+	void SetIntUniform(std::string varName, int value);
 };
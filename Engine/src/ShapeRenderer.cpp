@@ -0,0 +1,109 @@
+#include "ShapeRenderer.h"
+#include "Profiler.h"
+#include <cstddef>
+
+//Instances per region to start with. It doubles if a frame needs more.
+constexpr int InitialInstanceCapacity = 1 << 12;
+
+void ShapeRenderer::Initialise()
+{
+	InitialiseBatch(circles);
+	InitialiseBatch(boxes);
+	InitialiseBatch(points);
+	initialised = true;
+}
+
+ShapeRenderer::~ShapeRenderer()
+{
+	if (initialised)
+	{
+		glDeleteVertexArrays(1, &circles.vertexArrayID);
+		glDeleteVertexArrays(1, &boxes.vertexArrayID);
+		glDeleteVertexArrays(1, &points.vertexArrayID);
+		initialised = false;
+	}
+}
+
+void ShapeRenderer::InitialiseBatch(Batch& batch)
+{
+	GLuint vao;
+	glCreateVertexArrays(1, &vao);
+	glVertexArrayAttribFormat(vao, 0, 2, GL_FLOAT, GL_FALSE, offsetof(ShapeInstance, position));
+	glVertexArrayAttribFormat(vao, 1, 1, GL_FLOAT, GL_FALSE, offsetof(ShapeInstance, orientation));
+	glVertexArrayAttribFormat(vao, 2, 2, GL_FLOAT, GL_FALSE, offsetof(ShapeInstance, extents));
+	glVertexArrayAttribFormat(vao, 3, 4, GL_UNSIGNED_BYTE, GL_TRUE, offsetof(ShapeInstance, colour));
+	for (GLuint attrib = 0; attrib < 4; attrib++)
+	{
+		glVertexArrayAttribBinding(vao, attrib, 0);
+		glEnableVertexArrayAttrib(vao, attrib);
+	}
+	//Every attribute is per instance. The vertices themselves only exist in the shader.
+	glVertexArrayBindingDivisor(vao, 0, 1);
+
+	batch.vertexArrayID = vao;
+	batch.instances.Initialise(vao, 0, sizeof(ShapeInstance), InitialInstanceCapacity);
+}
+
+void ShapeRenderer::DrawCircle(Vec2 centre, float radius, Colour colour)
+{
+	if (!view.Overlaps(centre, radius)) return;
+
+	Batch& batch = view.IsSubPixel(radius * 2.0f) ? points : circles;
+	batch.instances.Push(ShapeInstance{ centre, 0.0f, { radius, radius }, colour.Pack() });
+}
+
+void ShapeRenderer::DrawBox(Vec2 centre, float orientation, Vec2 halfExtents, Colour colour)
+{
+	const float radius = halfExtents.GetMagnitude();
+	if (!view.Overlaps(centre, radius)) return;
+
+	Batch& batch = view.IsSubPixel(radius * 2.0f) ? points : boxes;
+	batch.instances.Push(ShapeInstance{ centre, orientation, halfExtents, colour.Pack() });
+}
+
+void ShapeRenderer::Clear()
+{
+	circles.instances.NextRegion();
+	circles.compiledCount = 0;
+	boxes.instances.NextRegion();
+	boxes.compiledCount = 0;
+	points.instances.NextRegion();
+	points.compiledCount = 0;
+}
+
+void ShapeRenderer::Compile()
+{
+	PROFILE_ZONE("ShapeRenderer::Compile");
+	//Same as the LineRenderer, the instances are already in mapped memory.
+	circles.compiledCount = circles.instances.GetCount();
+	boxes.compiledCount = boxes.instances.GetCount();
+	points.compiledCount = points.instances.GetCount();
+}
+
+void ShapeRenderer::Draw(ShaderProgram& shader)
+{
+	shader.SetFloatUniform("zoomFactor", view.zoomFactor);
+	shader.SetIntUniform("maxCircleSegments", MaxCircleSegments);
+
+	shader.SetIntUniform("shapeType", 0);
+	DrawBatch(circles, GL_LINE_LOOP, MaxCircleSegments);
+	shader.SetIntUniform("shapeType", 1);
+	DrawBatch(boxes, GL_LINE_LOOP, 4);
+	shader.SetIntUniform("shapeType", 2);
+	DrawBatch(points, GL_POINTS, 1);
+}
+
+void ShapeRenderer::DrawBatch(Batch& batch, GLenum mode, GLsizei vertexCount)
+{
+	if (batch.compiledCount == 0) return;
+
+	glBindVertexArray(batch.vertexArrayID);
+	glDrawArraysInstancedBaseInstance(mode, 0, vertexCount, batch.compiledCount, batch.instances.GetFirst());
+	glBindVertexArray(0);
+	batch.instances.Fence();
+}
+
+void ShapeRenderer::UpdateWithCameraInfo(Vec2 pos, float height, float aspect, int viewportPixelHeight)
+{
+	view.Update(pos, height, aspect, viewportPixelHeight);
+}
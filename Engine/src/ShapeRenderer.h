@@ -0,0 +1,64 @@
+#pragma once
+
+#include "Maths.h"
+#include "Graphics.h"
+#include "Colour.h"
+#include "StreamBuffer.h"
+#include "ShaderProgram.h"
+#include "ViewBounds.h"
+
+//Everything the GPU needs to draw one shape. The outline gets built from this in Shape.vsd.
+struct ShapeInstance
+{
+	Vec2 position;
+	float orientation;
+	//Radius (in x) for circles, half extents for boxes.
+	Vec2 extents;
+	uint32_t colour;
+};
+static_assert(sizeof(ShapeInstance) == 24);
+
+//Draws circle and box outlines as one instance each, rather than going through the LineRenderer a segment at a time.
+//Only the instance data gets uploaded, so it costs the same no matter how many segments a circle ends up with.
+class ShapeRenderer
+{
+private:
+	struct Batch
+	{
+		GLuint vertexArrayID = 0;
+		StreamBuffer instances;
+		int compiledCount = 0;
+	};
+
+	Batch circles;
+	Batch boxes;
+	//Shapes too small to make out on screen, drawn as a single pixel.
+	Batch points;
+	bool initialised = false;
+
+	ViewBounds view;
+
+	void InitialiseBatch(Batch& batch);
+	void DrawBatch(Batch& batch, GLenum mode, GLsizei vertexCount);
+
+public:
+	ShapeRenderer() = default;
+	~ShapeRenderer();
+	ShapeRenderer(const ShapeRenderer&) = delete;
+	const ShapeRenderer& operator=(const ShapeRenderer&) = delete;
+
+	//Circles never get more segments than this, however big they are on screen.
+	static constexpr int MaxCircleSegments = 128;
+
+	void Initialise();
+
+	void DrawCircle(Vec2 centre, float radius, Colour colour);
+	void DrawBox(Vec2 centre, float orientation, Vec2 halfExtents, Colour colour);
+
+	void Clear();
+	void Compile();
+	//Expects shader to be Shape.vsd, already in use with its vpMatrix set.
+	void Draw(ShaderProgram& shader);
+
+	void UpdateWithCameraInfo(Vec2 pos, float height, float aspect, int viewportPixelHeight = 0);
+};
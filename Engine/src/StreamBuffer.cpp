@@ -0,0 +1,93 @@
+#include "StreamBuffer.h"
+#include "Profiler.h"
+
+constexpr GLbitfield StreamingFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+void StreamBuffer::Initialise(GLuint vertexArray, GLuint binding, int elementSize, int capacity)
+{
+	vertexArrayID = vertexArray;
+	bindingIndex = binding;
+	stride = elementSize;
+	Create(capacity);
+}
+
+StreamBuffer::~StreamBuffer()
+{
+	if (bufferID)
+	{
+		DeleteFences();
+		glUnmapNamedBuffer(bufferID);
+		glDeleteBuffers(1, &bufferID);
+	}
+}
+
+void StreamBuffer::Create(int capacity)
+{
+	regionCapacity = capacity;
+	const GLsizeiptr size = (GLsizeiptr)capacity * StreamRegions * stride;
+
+	glCreateBuffers(1, &bufferID);
+	glNamedBufferStorage(bufferID, size, nullptr, StreamingFlags);
+	mapped = (char*)glMapNamedBufferRange(bufferID, 0, size, StreamingFlags);
+
+	glVertexArrayVertexBuffer(vertexArrayID, bindingIndex, bufferID, 0, stride);
+}
+
+void StreamBuffer::Grow()
+{
+	PROFILE_ZONE("StreamBuffer::Grow");
+	GLuint oldBuffer = bufferID;
+	const GLintptr base = (GLintptr)region * regionCapacity;
+
+	Create(regionCapacity * 2);
+
+	//Whatever's been written so far this frame goes to the start of the new buffer, and carries on from there.
+	glCopyNamedBufferSubData(oldBuffer, bufferID, base * stride, 0, (GLsizeiptr)count * stride);
+
+	//NOTE: Deleting a buffer unmaps it as well.
+	glDeleteBuffers(1, &oldBuffer);
+	DeleteFences();
+
+	region = 0;
+}
+
+void StreamBuffer::NextRegion()
+{
+	region = (region + 1) % StreamRegions;
+	WaitForRegion(region);
+	count = 0;
+}
+
+void StreamBuffer::Fence()
+{
+	if (regionFences[region]) glDeleteSync(regionFences[region]);
+	regionFences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+void StreamBuffer::WaitForRegion(int index)
+{
+	GLsync& fence = regionFences[index];
+	if (!fence) return;
+
+	//NOTE: Only ends up waiting when the GPU is more than StreamRegions - 1 frames behind, which shouldn't normally happen.
+	GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+	while (result == GL_TIMEOUT_EXPIRED)
+	{
+		result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+	}
+	glDeleteSync(fence);
+	fence = 0;
+}
+
+void StreamBuffer::DeleteFences()
+{
+	//Deleting a buffer the GPU is still reading from is fine, GL hangs on to it until it's done. So the fences can just go.
+	for (GLsync& fence : regionFences)
+	{
+		if (fence)
+		{
+			glDeleteSync(fence);
+			fence = 0;
+		}
+	}
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Graphics.h"
+
+//How many frames' worth of data can be in flight at once. The GPU can still be drawing from one region while we write the next.
+constexpr int StreamRegions = 3;
+
+//A vertex buffer for stuff that gets rewritten every frame. It stays mapped for as long as it exists, so things get written
+//straight into it, and it's split into StreamRegions regions so we're never writing over what the GPU is still reading.
+//Call NextRegion() before writing each frame, and Fence() after drawing.
+//
+//NOTE: It grows if it runs out of room, which means a new buffer, so it keeps the vertex array's binding pointed at whichever is current.
+class StreamBuffer
+{
+private:
+	GLuint bufferID = 0;
+	GLuint vertexArrayID = 0;
+	GLuint bindingIndex = 0;
+
+	char* mapped = nullptr;
+	int stride = 0;
+	int regionCapacity = 0;
+	int region = 0;
+	int count = 0;
+
+	//Set after drawing from a region, so we know when the GPU is done with it.
+	GLsync regionFences[StreamRegions] = {};
+
+	void Create(int capacity);
+	void Grow();
+	void WaitForRegion(int index);
+	void DeleteFences();
+
+public:
+	StreamBuffer() = default;
+	~StreamBuffer();
+	StreamBuffer(const StreamBuffer&) = delete;
+	const StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+	//The vertex array's binding at bindingIndex gets pointed at this buffer, with a stride of elementSize.
+	void Initialise(GLuint vertexArray, GLuint binding, int elementSize, int capacity);
+
+	void NextRegion();
+	void Fence();
+
+	//Room for one more element, straight in the mapped buffer.
+	void* Allocate()
+	{
+		if (count == regionCapacity) Grow();
+		return mapped + ((size_t)region * regionCapacity + count++) * stride;
+	}
+
+	template<typename T>
+	void Push(const T& element) { *(T*)Allocate() = element; }
+
+	int GetCount() const { return count; }
+	//Where this frame's elements start, for the first vertex or base instance of the draw call.
+	int GetFirst() const { return region * regionCapacity; }
+};
@@ -1,5 +1,6 @@
 #include "TextStream.h"
 #include <string>
+#include <charconv>
 #include "LineRenderer.h"
 
 TextStream::TextStream(LineRenderer* linesPointer, Vec2 startPos, float sizeInit, Colour initialColour)
@@ -36,7 +37,16 @@ TextStream& TextStream::operator<<(const std::string& text)
 
 TextStream& TextStream::operator<<(int num)
 {
-    cursorPos.x += lines->DrawText(std::to_string(num), cursorPos, size, currentColour);
+    //Big enough for any int, and it saves making a string just to draw it.
+    char digits[12];
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), num);
+    cursorPos.x += lines->DrawText(std::string_view(digits, result.ptr - digits), cursorPos, size, currentColour);
+    return *this;
+}
+
+TextStream& TextStream::operator<<(const CachedText& text)
+{
+    cursorPos.x += lines->DrawText(text, cursorPos, size, currentColour);
     return *this;
 }
 
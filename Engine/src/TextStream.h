@@ -1,5 +1,6 @@
 #pragma once
 class LineRenderer;
+class CachedText;
 #include "Vec2.h"
 #include "Colour.h"
 #include <string>
@@ -24,6 +25,7 @@ public:
 	TextStream& operator<<(const char* text);
 	TextStream& operator<<(const std::string& text);
 	TextStream& operator<<(int num);
+	TextStream& operator<<(const CachedText& text);
 	TextStream& operator<<(Vec2 vec);
 	TextStream& operator<<(char character);
 	TextStream& operator<<(Colour newColour);
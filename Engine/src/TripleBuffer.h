@@ -0,0 +1,42 @@
+#pragma once
+#include <atomic>
+
+//Hands values from one writer thread to one reader thread without either of them ever waiting on the other. There are three
+//slots: the one the writer is filling, the one the reader is looking at, and the newest finished one. Publishing swaps the writer's
+//slot with the newest one, and the reader swaps its slot with the newest one whenever there's something it hasn't seen.
+//
+//The writer always has a slot to itself, so it never overwrites anything the reader is using, and the reader always gets the most
+//recently published value (older ones that it never got around to just get written over).
+template <typename T>
+class TripleBuffer
+{
+public:
+	//Writer side. Fill this in, then Publish() it.
+	T& GetWriteBuffer() { return slots[writeIndex]; }
+	void Publish()
+	{
+		writeIndex = latest.exchange(writeIndex | FreshBit, std::memory_order_acq_rel) & IndexMask;
+	}
+
+	//Reader side. Acquire() returns whether there was anything new, in which case GetReadBuffer() now has it. The reader's slot
+	//belongs to the reader until the next Acquire(), so it's free to move things out of it.
+	bool HasNew() const { return (latest.load(std::memory_order_relaxed) & FreshBit) != 0; }
+	bool Acquire()
+	{
+		if (!HasNew()) return false;
+		readIndex = latest.exchange(readIndex, std::memory_order_acq_rel) & IndexMask;
+		return true;
+	}
+	T& GetReadBuffer() { return slots[readIndex]; }
+	const T& GetReadBuffer() const { return slots[readIndex]; }
+
+private:
+	//The newest slot's index, with a bit set until the reader has picked it up.
+	static constexpr int IndexMask = 3;
+	static constexpr int FreshBit = 4;
+
+	T slots[3];
+	int writeIndex = 0;
+	int readIndex = 1;
+	std::atomic<int> latest = 2;
+};
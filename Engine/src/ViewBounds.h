@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Maths.h"
+
+#ifdef linux
+#include <cfloat>
+#endif
+
+//What part of the world the camera can currently see, so the renderers can skip anything outside it and simplify anything
+//too small to make out. Until Update() gets called it covers everything, and nothing counts as small.
+struct ViewBounds
+{
+	float xMin = -FLT_MAX;
+	float xMax = FLT_MAX;
+	float yMin = -FLT_MAX;
+	float yMax = FLT_MAX;
+	float zoomFactor = 1.0f;
+	//0 when we don't know how big the window is.
+	float pixelsPerUnit = 0.0f;
+
+	void Update(Vec2 pos, float height, float aspect, int viewportPixelHeight)
+	{
+		float halfHeight = height / 2;
+		float halfWidth = halfHeight * aspect;
+		xMin = pos.x - halfWidth;
+		xMax = pos.x + halfWidth;
+		yMin = pos.y - halfHeight;
+		yMax = pos.y + halfHeight;
+
+		zoomFactor = 10.0f / height;
+		pixelsPerUnit = viewportPixelHeight / height;
+	}
+
+	bool Overlaps(Vec2 min, Vec2 max) const
+	{
+		return max.x > xMin && min.x < xMax && max.y > yMin && min.y < yMax;
+	}
+
+	bool Overlaps(Vec2 centre, float radius) const
+	{
+		return centre.x > xMin - radius && centre.x < xMax + radius && centre.y > yMin - radius && centre.y < yMax + radius;
+	}
+
+	bool OverlapsSegment(Vec2 start, Vec2 end) const
+	{
+		return Overlaps(Vec2(fminf(start.x, end.x), fminf(start.y, end.y)), Vec2(fmaxf(start.x, end.x), fmaxf(start.y, end.y)));
+	}
+
+	//True when something this size (in world units) would cover fewer than that many pixels on screen.
+	bool IsSmallerThan(float size, float pixels) const
+	{
+		return pixelsPerUnit > 0.0f && size * pixelsPerUnit < pixels;
+	}
+
+	bool IsSubPixel(float size) const { return IsSmallerThan(size, 1.0f); }
+
+	float GetPixelSize() const
+	{
+		return pixelsPerUnit > 0.0f ? 1.0f / pixelsPerUnit : 0.0f;
+	}
+};
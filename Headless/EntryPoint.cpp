@@ -0,0 +1,129 @@
+#include "PhysicsWorld.h"
+#include "Profiler.h"
+#include "Serialiser.h"
+#include "Utilities.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+// Loads a scene saved from the editor, steps it a fixed number of ticks as fast as it can, and writes out where everything ended up
+// along with how long it took.
+//
+// Usage: Headless <scene.json> [--ticks N] [--dt seconds] [--threads N] [--out file] [--trace file]
+//
+// Each tick goes through PhysicsWorld::Simulate, the same as the editor, and --dt defaults to the editor's 120Hz fixed step, so a
+// scene ends up in the same place whichever one it runs in.
+//
+// --trace writes every profiler zone from the run to a trace event file, for chrome://tracing or ui.perfetto.dev.
+
+static void PrintUsage()
+{
+	std::cerr << "Usage: Headless <scene.json> [--ticks N] [--dt seconds] [--threads N] [--out file] [--trace file]\n";
+}
+
+int main(int argc, char** argv)
+{
+	const char* scenePath = nullptr;
+	const char* outPath = nullptr;
+	const char* tracePath = nullptr;
+	int ticks = 600;
+	float timeStep = 1.0f / 120.0f;
+	int threads = 0;
+
+	for (int i = 1; i < argc; i++) {
+		const bool hasValue = i + 1 < argc;
+
+		if (strcmp(argv[i], "--ticks") == 0 && hasValue) ticks = atoi(argv[++i]);
+		else if (strcmp(argv[i], "--dt") == 0 && hasValue) timeStep = static_cast<float>(atof(argv[++i]));
+		else if (strcmp(argv[i], "--threads") == 0 && hasValue) threads = atoi(argv[++i]);
+		else if (strcmp(argv[i], "--out") == 0 && hasValue) outPath = argv[++i];
+		else if (strcmp(argv[i], "--trace") == 0 && hasValue) tracePath = argv[++i];
+		else if (argv[i][0] != '-' && !scenePath) scenePath = argv[i];
+		else {
+			PrintUsage();
+			return 1;
+		}
+	}
+
+	if (!scenePath || ticks < 0 || timeStep <= 0.0f) {
+		PrintUsage();
+		return 1;
+	}
+
+	const std::string contents = LoadFileAsString(scenePath);
+	if (contents.empty()) return 1;
+
+	PhysicsWorld world(threads);
+	Serialiser serialiser;
+
+	try {
+		serialiser.Load(&world, contents.c_str());
+	}
+	catch (const json::exception& e) {
+		std::cerr << "Failed to load " << scenePath << ": " << e.what() << '\n';
+		return 1;
+	}
+
+	Profiler::SetThreadName("Main");
+#ifndef ENGINE_PROFILER
+	if (tracePath) {
+		std::cerr << "Built without ENGINE_PROFILER, so there is nothing to trace\n";
+		return 1;
+	}
+#endif
+	if (tracePath && !Profiler::StartCapture(tracePath)) {
+		std::cerr << "Failed to open " << tracePath << '\n';
+		return 1;
+	}
+
+	double totalMs = 0.0;
+	double maxTickMs = 0.0;
+
+	for (int tick = 0; tick < ticks; tick++) {
+		const auto start = std::chrono::steady_clock::now();
+		world.Simulate(timeStep);
+		const auto end = std::chrono::steady_clock::now();
+
+		const double tickMs = std::chrono::duration<double, std::milli>(end - start).count();
+		totalMs += tickMs;
+		maxTickMs = std::max(maxTickMs, tickMs);
+
+		// NOTE: Outside the timed bit, since this is where the capture gets written out.
+		Profiler::EndFrame();
+	}
+
+	if (tracePath) Profiler::StopCapture();
+
+	json output = serialiser.Save(world.GetActors());
+	output["Run"] = {
+		{ "scene", scenePath },
+		{ "ticks", ticks },
+		{ "timestep", timeStep },
+		{ "threads", world.GetThreadCount() },
+		{ "actors", world.GetActors().size() },
+		{ "awakebodies", world.GetBodies().GetAwakeCount() },
+		{ "totalms", totalMs },
+		{ "meantickms", ticks > 0 ? totalMs / ticks : 0.0 },
+		{ "maxtickms", maxTickMs },
+	};
+
+	const std::string stringified = output.dump(3);
+
+	if (!outPath) {
+		std::cout << stringified << '\n';
+		return 0;
+	}
+
+	std::ofstream file(outPath);
+	if (!file.is_open()) {
+		std::cerr << "Failed to open " << outPath << '\n';
+		return 1;
+	}
+	file << stringified << '\n';
+
+	return 0;
+}